@@ -0,0 +1,80 @@
+#ifndef __BackgroundPool__
+#define __BackgroundPool__
+
+
+#include <deque>
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+#include <algorithm>
+
+
+// worker threads of the background work of the sessions (live mode runs, the optimum), apart from the threads
+// that serve the requests, so a long calculation never holds up a page, a download or the api
+// the no. of threads is fixed & at most queueLimit tasks wait: post() refuses more, so a burst of edits of many
+// sessions can't pile up work (the caller tries again later)
+class BackgroundPool {
+    
+    std::mutex                          mutex_;       // guards tasks_ & stopping_
+    std::condition_variable             wakeUp_;      // a task is waiting, or the pool stops
+    std::deque<std::function<void()>>   tasks_;       // waiting for a thread, oldest first
+    std::vector<std::thread>            threads_;
+    std::size_t                         queueLimit_;
+    bool                                stopping_;
+    
+    void work(){
+        while (true){
+            std::function<void()> task;
+            {
+                std::unique_lock<std::mutex> lock(mutex_);
+                wakeUp_.wait(lock, [this](){ return  stopping_  or  not tasks_.empty(); });
+                if (stopping_)  return;
+                task = std::move(tasks_.front());
+                tasks_.pop_front();
+            }
+            task();
+        }
+    }
+    
+    public:
+    // 0 threads: one per cpu, 0 queue limit: 4 tasks per thread
+    explicit BackgroundPool(unsigned threadCount = 0, std::size_t queueLimit = 0) : stopping_(false) {
+        if (not threadCount)  threadCount = std::max(1u, std::thread::hardware_concurrency());
+        queueLimit_ = (queueLimit) ? queueLimit : 4 * threadCount;
+        for (unsigned t = 0; t < threadCount; ++t){ threads_.emplace_back(&BackgroundPool::work, this); }
+    }
+    ~BackgroundPool(){ stop(); }
+    
+    // false if the queue is full or the pool is stopped, then the task is dropped
+    bool post(std::function<void()> task){
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (stopping_  or  tasks_.size() >= queueLimit_)  return false;
+            tasks_.push_back(std::move(task));
+        }
+        wakeUp_.notify_one();
+        return true;
+    }
+    
+    // the waiting tasks are dropped, the running ones finish first (e.g. before the server they post to is gone)
+    void stop(){
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            stopping_ = true;
+            tasks_.clear();
+        }
+        wakeUp_.notify_all();
+        for (auto &thread : threads_){ if (thread.joinable())  thread.join(); }
+    }
+    
+    // the pool of the sessions of the server
+    static BackgroundPool &instance(){
+        static BackgroundPool pool;
+        return pool;
+    }
+};
+
+
+#endif // __BackgroundPool__
@@ -0,0 +1,104 @@
+#ifndef __Batch__
+#define __Batch__
+
+
+#include <vector>
+#include <deque>
+#include <string>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <functional>
+#include <algorithm>
+
+#include "Engine.hpp"
+#include "Statistics.hpp"
+
+
+// runs a fixed no. of independent tasks on worker threads
+// every worker starts with its own contiguous block of tasks, takes them from the back of its deque,
+// and once its deque is empty, steals from the front of the others; so uneven tasks still keep all threads busy
+class WorkStealingPool {
+    
+    struct WorkerQueue {
+        std::mutex               mutex;
+        std::deque<std::size_t>  tasks;
+    };
+    
+    unsigned threadCount_;
+    
+    public:
+    explicit WorkStealingPool(unsigned threadCount = 0)
+        : threadCount_((threadCount) ? threadCount : std::max(1u, std::thread::hardware_concurrency())) {}
+    
+    unsigned threadCount() const { return threadCount_; }
+    
+    // calls task(worker, i) once for every i in [0, taskCount), returns after all of them are done
+    void run(const std::size_t &taskCount, const std::function<void(unsigned, std::size_t)> &task) const {
+        
+        unsigned workers = std::max<std::size_t>(1, std::min<std::size_t>(threadCount_, taskCount));
+        std::vector<std::unique_ptr<WorkerQueue>> queues;
+        for (unsigned w = 0; w < workers; ++w){
+            queues.push_back(std::make_unique<WorkerQueue>());
+            for (std::size_t i = taskCount * w / workers; i < taskCount * (w + 1) / workers; ++i){
+                queues[w]->tasks.push_back(i);
+            }
+        }
+        // next task of a worker: its own newest one, otherwise the oldest one of another worker
+        auto nextTask = [&](const unsigned worker, std::size_t &taskIndex){
+            for (unsigned k = 0; k < workers; ++k){
+                WorkerQueue &queue = *queues[(worker + k) % workers];
+                std::lock_guard<std::mutex> lock(queue.mutex);
+                if (queue.tasks.empty())  continue;
+                
+                if (k == 0){ taskIndex = queue.tasks.back();   queue.tasks.pop_back(); }
+                else {       taskIndex = queue.tasks.front();  queue.tasks.pop_front(); }
+                return true;
+            }
+            return false; // no new tasks are ever added, so all work is taken
+        };
+        auto work = [&](const unsigned worker){
+            std::size_t taskIndex;
+            while (nextTask(worker, taskIndex)){ task(worker, taskIndex); }
+        };
+        
+        std::vector<std::thread> threads;
+        for (unsigned w = 1; w < workers; ++w){ threads.emplace_back(work, w); }
+        work(0); // the calling thread is worker 0
+        for (auto &thread : threads){ thread.join(); }
+    }
+};
+
+
+struct BatchResult { // results of simulateBatch()
+    std::vector<ScheduleStatistics> shards;   // statistics of each workload
+    ScheduleStatistics              total;    // all workloads together
+};
+
+
+// simulates independent workloads (e.g. the traces of the hosts of a farm), each one on its own single cpu,
+// in parallel on a work-stealing pool; every worker reuses one engine without checkpoints
+inline BatchResult simulateBatch(const std::vector<std::vector<Process>> &workloads, const std::string &algorithm,
+                                 const double &timeQuantum, const unsigned &threadCount = 0){
+    
+    WorkStealingPool pool(threadCount);
+    std::vector<SchedulingEngine> engines(pool.threadCount());
+    for (auto &engine : engines){ engine.setCheckpointing(false); }
+    
+    BatchResult result;
+    result.shards.resize(workloads.size());
+    
+    // each shard writes only its own statistics, so the workers share nothing
+    bool hasSecondBurst = (algorithm == "IO");
+    pool.run(workloads.size(), [&](const unsigned worker, const std::size_t shard){
+        SchedulingEngine &engine = engines[worker];
+        engine.simulate(workloads[shard], algorithm, timeQuantum);
+        for (const auto &process : engine.processes()){ result.shards[shard].add(process, hasSecondBurst); }
+    });
+    
+    for (const auto &shard : result.shards){ result.total.merge(shard); }
+    return result;
+}
+
+
+#endif // __Batch__
@@ -43,43 +43,25 @@
 #include <Wt/WMessageBox.h>
 #include <Wt/WAnimation.h>
 #include <Wt/WJavaScript.h>
+#include <Wt/WCheckBox.h>
+#include <Wt/WTimer.h>
+#include <Wt/WServer.h>
+#include <Wt/WAnchor.h>
+#include <Wt/WEvent.h>
 
 #include <vector>
 #include <string>
+#include <memory>
+#include <atomic>
 
-using namespace Wt;
-
-
-struct Process { // structure for process information
-    short int  id;
-    int        priority;
-    double     arrivalTime;
-    double     burstTime;
-    double     burstTime2;
-    double     waitingTime;
-    double     turnaroundTime;
-    double     completionTime;
-    double     responseTime;
-    double     remainingTime;
-    double     remainingTime2;
-    double     ioTime;
-    bool       started;
-    
-    Process() : id(0), arrivalTime(0), burstTime(0), burstTime2(0), ioTime(0), priority(0), 
-                waitingTime(0), turnaroundTime(0), completionTime(0), responseTime(0), 
-                remainingTime(0), remainingTime2(0), started(false) {}
-};
+#include "Engine.hpp"
+#include "Statistics.hpp"
+#include "Optimal.hpp"
+#include "Exports.hpp"
+#include "ScheduleApi.hpp"
+#include "BackgroundPool.hpp"
 
-
-struct GanttSegment { // segemnts for grant chart creation
-    short int    processId;
-    double       startTime;
-    double       endTime;
-    std::string  color;
-    
-    GanttSegment(int id, double start, double end, const std::string &c) 
-        : processId(id), startTime(start), endTime(end), color(c) {}
-};
+using namespace Wt;
 
 
 // main class for creating the whole application
@@ -98,6 +80,20 @@ class ProcessSchedulingCalculator : public Wt::WApplication {
     Wt::WComboBox      *algorithmComboBox_;          // drop-down selection box for different algorithm selection
     Wt::WSpinBox       *processCountSpinBox_;        // process input box, to specify no. of processes
     Wt::WDoubleSpinBox *quantumSpinBox_;             // time quantum input box, for RR algorithm
+    Wt::WSpinBox       *mlfqLevelsSpinBox_;          // no. of levels input box, for MLFQ algorithm
+    Wt::WDoubleSpinBox *mlfqBoostSpinBox_;           // priority boost interval input box, for MLFQ algorithm
+    Wt::WDoubleSpinBox *cfsLatencySpinBox_;          // target latency input box, for CFS algorithm
+    Wt::WDoubleSpinBox *cfsGranularitySpinBox_;      // minimum granularity input box, for CFS algorithm
+    Wt::WSpinBox       *ioDevicesSpinBox_;           // no. of i/o devices input box, for IO algorithm
+    Wt::WComboBox      *ioDisciplineComboBox_;       // drop-down selection box for the queue discipline of the i/o devices
+    Wt::WDoubleSpinBox *realTimeHorizonSpinBox_;     // horizon of the periodic releases input box, for EDF & RMS
+    Wt::WSpinBox       *coreCountSpinBox_;           // cpu count input box, to simulate a multi-core host
+    Wt::WComboBox      *runQueueComboBox_;           // drop-down selection box for the run queue layout of the cpus
+    Wt::WDoubleSpinBox *contextSwitchSpinBox_;       // cost of a context switch input box
+    Wt::WDoubleSpinBox *migrationSpinBox_;           // extra cost of moving a process to another cpu input box
+    Wt::WDoubleSpinBox *cacheWarmupSpinBox_;         // cost of refilling the cache of a resumed process input box
+    Wt::WComboBox      *optimalComboBox_;            // drop-down selection box for the objective compared with its optimum
+    Wt::WCheckBox      *liveModeCheckBox_;           // live mode toggle, to recalculate the results while typing
     Wt::WTable         *processTable_;               // process input table (At,Bt,Pr)
     Wt::WPushButton    *addProcessButton_;           // add process button to add a new process to the process input table
     Wt::WPushButton    *removeProcessButton_;        // remove process button to remove a process from the process input table
@@ -105,21 +101,49 @@ class ProcessSchedulingCalculator : public Wt::WApplication {
     Wt::WPushButton    *clearButton_;                // clear button to clear the results
     
     // Result widgets for resultContainer_
-    Wt::WText  *ganttChartText_;                     // grantt chart (process - id & completion time)
-    Wt::WTable *statisticsTable_;                    // process output table 
-    Wt::WText  *averageBurstTimeText_;               // average burst time (throughput)
+    Wt::WText  *ganttChartText_;                     // messages of the gantt chart (e.g. no processes)
+    Wt::WContainerWidget *ganttChart_;               // grantt chart, drawn by the browser (gantt.js) from ganttData_
+    Wt::WTable *statisticsTable_;                    // process output table
+    Wt::WText  *throughputText_;                     // completed processes per unit time
+    Wt::WText  *cpuUtilizationText_;                 // busy share of the cpus
     Wt::WText  *averageWaitingTimeText_;             // average waiting time
     Wt::WText  *averageTurnaroundTimeText_;          // average turn-around time
     Wt::WText  *averageResponseTimeText_;            // average response time
+    Wt::WText  *waitingPercentilesText_;             // p50, p90, p99 & max waiting time
+    Wt::WText  *responsePercentilesText_;            // p50, p90, p99 & max response time
+    Wt::WText  *deadlineText_;                       // deadline misses & lateness (EDF & RMS only)
+    Wt::WText  *overheadText_;                       // time spent switching between the processes (with switch costs only)
+    Wt::WText  *optimalText_;                        // the objective of the results next to its optimum (if selected)
+    Wt::WText  *profileText_;                        // phase timings & engine counters (profiling builds only)
     
     // Data handling 
     std::vector<Process>      processes_;            // data-structure to hold each process details.
-    std::vector<GanttSegment> ganttSegments_;        // data-structure to hold each process details.
+    SchedulingEngine          engine_;               // runs the algorithms, holds the results & the gantt segments
     std::string               selectedAlgorithm_;    // current selected algorithm name
     short int                 currentProcessCount_;  // current no. of processes
     double                    timeQuantum_;          // time quantum value
+    CpuConfig                 cpuConfig_;            // cpu count & run queue layout
+    MlfqConfig                mlfqConfig_;           // MLFQ levels & boost interval
+    CfsConfig                 cfsConfig_;            // CFS target latency & minimum granularity
+    IoConfig                  ioConfig_;             // IO devices & their queue discipline
+    RealTimeConfig            realTimeConfig_;       // EDF & RMS release horizon
+    SwitchCostConfig          switchCostConfig_;     // context switch, migration & cache warm-up costs
+    unsigned                  resultsVersion_;       // increased whenever the results change (resets the gantt data of the browser, drops older optimum searches)
     
-    std::vector<std::string> processColors_;         // color palette for processes to show in grantt chart
+    std::shared_ptr<GanttDataResource> ganttData_;   // packed gantt segments for the browser
+    std::size_t               ganttClientSegments_;  // segments the browser has after the last chart update
+    
+    // Live mode
+    Wt::WTimer                             *liveTimer_;       // debounce timer, restarted on every input edit
+    std::shared_ptr<std::atomic<unsigned>>  liveGeneration_;  // increased on every edit, older background runs stop
+    
+    // Comparison with the optimum
+    std::vector<double>                     optimalInputs_;   // objective & inputs of the processes of optimum_
+    OptimalSchedule                         optimum_;         // last search, reused while its inputs don't change
+    unsigned                                optimalSearches_; // searches on the background pool, server push is on meanwhile
+    
+    // Profiling (see Profiling.hpp)
+    PhaseTimings                            phaseTimings_;    // time spent in each phase by this session
     
     
     /* Here only the internal function calling of memeber functions is listed, 
@@ -133,47 +157,52 @@ class ProcessSchedulingCalculator : public Wt::WApplication {
     void setupAlgorithmSelection();        // onProcessCountChanged, onAlgorithmChanged(), 
     void setupProcessInputTable();         // onAddProcessClicked(), onRemoveProcessClicked()
     void setupControlButtons();            // onCalculateClicked(), onClearClicked()
-    void setupResultsSection();            // setupGanttChart(), setupStatisticsTable()
-    void setupGanttChart();                // 
+    void setupResultsSection();            // empty results container, filled by setupResultsWidgets() on the first results
+    void setupResultsWidgets();            // setupGanttChart(), setupStatisticsTable(), setupExportLinks()
+    void setupGanttChart();                // gantt.js, GanttDataResource & the shared style of the gantt cells
     void setupStatisticsTable();           //
+    void setupExportLinks();               // ScheduleExportResource for each format, ProfileReportResource
     void setupFooter();                    //
     
     // Event handlers
     
     void onProcessCountChanged();          // updateProcessTable()
     void onAlgorithmChanged();             // clearResults()
-    void onCalculateClicked();             // validateInputs(), display'x'Results(), showAlertMessage()
+    void onCalculateClicked();             // validateInputs(), engine_.simulate(), updateGanttChart(), updateStatistics()
     void onClearClicked();                 // clearResults(), showAlertMessage()
     void onAddProcessClicked();            // onProcessCountChanged() or showAlertMessage()
     void onRemoveProcessClicked();         // onProcessCountChanged() or showAlertMessage()
+    void onLiveModeChanged();              // onInputEdited()
+    void onInputEdited();                  // restarts liveTimer_ (live mode only)
+    void onLiveTimeout();                  // validateInputs(), readProcessTable(), engine_.detach() simulated on the BackgroundPool, showResults()
     bool validateInputs();                 // showAlertMessage()
-    
-    // Algorithm implementations
-    
-    void displayFCFSResults();             //  , updateGanttChart(), updateStatistics()
-    void displaySJFResults();              //  , updateGanttChart(), updateStatistics()
-    void displayPriorityResults();         //  , updateGanttChart(), updateStatistics()
-    void displayRoundRobinResults();       //  , updateGanttChart(), updateStatistics()
-    void displaySRTFResults();             //  , updateGanttChart(), updateStatistics()
-    void displayPRPResults();              //  , updateGanttChart(), updateStatistics()
-    void displayIOResults();               //  , updateGanttChart(), updateStatistics()
+    void readProcessTable();               // 
+    void readCpuConfig();                  // 
+    void readMlfqConfig();                 // 
+    void readCfsConfig();                  // 
+    void readIoConfig();                   // 
+    void readRealTimeConfig();             // 
+    void readSwitchCostConfig();           // 
     
     // UI update methods
     
-    void updateProcessTable(const short int &newProcessCount);         // 
-    void updateGanttChart(const std::vector<GanttSegment> &segments);  // generateGanttHTML()
-    void updateStatistics(const std::vector<Process> &processes);      // 
+    void updateProcessTable(const short int &newProcessCount);         // onInputEdited() on every value change
+    void showResults(const std::size_t &firstChangedSegment);          // updateGanttChart(), updateStatistics()
+    void updateGanttChart(const std::vector<GanttSegment> &segments, const std::size_t &firstChangedSegment); // SchedulerGantt.update()
+    void updateStatistics(const std::vector<Process> &processes);      // patches the changed rows only
+    void updateOptimalComparison(const std::vector<Process> &processes); // solveOptimal() on the BackgroundPool, showOptimalComparison()
+    void showOptimalComparison(const std::string &objective, const double &value, const OptimalSchedule &optimum); // 
     void showAlertMessage(const std::string &message, const bool &messageTypeIsSuccess);
     void clearResults();                                               //
+    void showProfile();                                                // phaseTimings_ & engine_.counters() (profiling builds only)
     
-    // Helper methods
-    
-    std::string generateGanttHTML(const std::vector<GanttSegment> &segments);  //
-    std::string getProcessColor(const short int processId);                    // 
     
+    protected:
+    void notify(const Wt::WEvent &event) override;   // every request of the session (event handling + rendering)
     
     public:
     ProcessSchedulingCalculator(const Wt::WEnvironment &env);
+    ~ProcessSchedulingCalculator();
 };
 
 
@@ -18,13 +18,6 @@ inline void ProcessSchedulingCalculator::createInterface() {
     auto theme = std::make_shared<Wt::WBootstrap5Theme>();
     setTheme(theme);
     
-    // Initialize process colors
-    processColors_ = {
-        "#FF6B6B", "#4ECDC4", "#45B7D1", "#96CEB4", "#FFEAA7",
-        "#DDA0DD", "#98D8C8", "#F7DC6F", "#BB8FCE", "#85C1E9",
-        "#F8C471", "#82E0AA", "#F1948A", "#85929E", "#D7BDE2"
-    };
-    
     // Main container with Bootstrap classes
     mainContainer_ = root()->addNew<WContainerWidget>();
     mainContainer_->setStyleClass("container-fluid");
@@ -67,7 +60,7 @@ inline void ProcessSchedulingCalculator::setupHeader(){
     auto navContainer = headerSection->addNew<WContainerWidget>();
     navContainer->setStyleClass("nav nav-tabs justify-content-center mt-4");
     
-    auto algorithmInfo = headerSection->addNew<WText>("Supports: FCFS, SJF, SRTF, Round Robin, Priority and IO scheduling");
+    auto algorithmInfo = headerSection->addNew<WText>("Supports: FCFS, SJF, SRTF, Round Robin, Priority, IO, MLFQ and CFS scheduling, on one or more CPUs");
     algorithmInfo->setStyleClass("small text-info mt-3");   // sub-sub-heading text & style
     
     headerSection->addNew<WBreak>();
@@ -144,6 +137,12 @@ inline void ProcessSchedulingCalculator::setupAlgorithmSelection(){
     algorithmComboBox_->addItem("Shortest Remaining Time First (SRTF)");
     algorithmComboBox_->addItem("Priority Premetive (PRP)");
     algorithmComboBox_->addItem("Input-Output Scheduling (IO)");
+    algorithmComboBox_->addItem("Multilevel Feedback Queue (MLFQ)");
+    algorithmComboBox_->addItem("Completely Fair Scheduler (CFS)");
+    algorithmComboBox_->addItem("Earliest Deadline First (EDF)");
+    algorithmComboBox_->addItem("Rate Monotonic (RMS)");
+    algorithmComboBox_->addItem("Stride Scheduling (STRIDE)");
+    algorithmComboBox_->addItem("Lottery Scheduling (LOTTERY)");
     algorithmComboBox_->setCurrentIndex(0);
     algorithmComboBox_->changed().connect(this, &ProcessSchedulingCalculator::onAlgorithmChanged);
     
@@ -174,8 +173,203 @@ inline void ProcessSchedulingCalculator::setupAlgorithmSelection(){
     quantumSpinBox_->setValue(2.0);
     quantumSpinBox_->setDecimals(1);
     quantumSpinBox_->setSingleStep(0.5);
+    quantumSpinBox_->changed().connect(this, &ProcessSchedulingCalculator::onInputEdited);
+    quantumSpinBox_->textInput().connect(this, &ProcessSchedulingCalculator::onInputEdited);
     
     quantumGroup->hide(); // Initially hide quantum input (only needs for premetive types)
+    
+    auto mlfqGroup = cardBody->addNew<WContainerWidget>();
+    mlfqGroup->setStyleClass("mb-3");
+    mlfqGroup->setId("mlfq-group"); // MLFQ levels & boost container id
+    
+    auto mlfqLevelsLabel = mlfqGroup->addNew<WLabel>(" Queue Levels (quantum doubles per level): ");
+    mlfqLevelsLabel->setStyleClass("form-label"); // MLFQ levels label
+    
+    // no. of levels input box, level 0 gets the time quantum and every lower level twice as much
+    mlfqLevelsSpinBox_ = mlfqGroup->addNew<WSpinBox>();
+    mlfqLevelsSpinBox_->setStyleClass("form-control mb-2");
+    mlfqLevelsSpinBox_->setRange(1, 64);
+    mlfqLevelsSpinBox_->setValue(3);
+    mlfqLevelsSpinBox_->changed().connect(this, &ProcessSchedulingCalculator::onInputEdited);
+    mlfqLevelsSpinBox_->textInput().connect(this, &ProcessSchedulingCalculator::onInputEdited);
+    
+    auto mlfqBoostLabel = mlfqGroup->addNew<WLabel>(" Priority Boost Interval (0 = never): ");
+    mlfqBoostLabel->setStyleClass("form-label"); // MLFQ boost label
+    
+    // boost interval input box, every process goes back to level 0 this often
+    mlfqBoostSpinBox_ = mlfqGroup->addNew<WDoubleSpinBox>();
+    mlfqBoostSpinBox_->setStyleClass("form-control");
+    mlfqBoostSpinBox_->setRange(0.0, 9999.9);
+    mlfqBoostSpinBox_->setValue(0.0);
+    mlfqBoostSpinBox_->setDecimals(1);
+    mlfqBoostSpinBox_->setSingleStep(1.0);
+    mlfqBoostSpinBox_->changed().connect(this, &ProcessSchedulingCalculator::onInputEdited);
+    mlfqBoostSpinBox_->textInput().connect(this, &ProcessSchedulingCalculator::onInputEdited);
+    
+    mlfqGroup->hide(); // Initially hide MLFQ inputs (only needs for MLFQ)
+    
+    auto cfsGroup = cardBody->addNew<WContainerWidget>();
+    cfsGroup->setStyleClass("mb-3");
+    cfsGroup->setId("cfs-group"); // CFS latency & granularity container id
+    
+    auto cfsLatencyLabel = cfsGroup->addNew<WLabel>(" Target Latency: ");
+    cfsLatencyLabel->setStyleClass("form-label"); // CFS target latency label
+    
+    // target latency input box, every runnable process runs once in this period (weighted by priority)
+    cfsLatencySpinBox_ = cfsGroup->addNew<WDoubleSpinBox>();
+    cfsLatencySpinBox_->setStyleClass("form-control mb-2");
+    cfsLatencySpinBox_->setRange(0.1, 999.9);
+    cfsLatencySpinBox_->setValue(6.0);
+    cfsLatencySpinBox_->setDecimals(2);
+    cfsLatencySpinBox_->setSingleStep(0.5);
+    cfsLatencySpinBox_->changed().connect(this, &ProcessSchedulingCalculator::onInputEdited);
+    cfsLatencySpinBox_->textInput().connect(this, &ProcessSchedulingCalculator::onInputEdited);
+    
+    auto cfsGranularityLabel = cfsGroup->addNew<WLabel>(" Minimum Granularity: ");
+    cfsGranularityLabel->setStyleClass("form-label"); // CFS minimum granularity label
+    
+    // minimum granularity input box, the shortest slice of a process
+    cfsGranularitySpinBox_ = cfsGroup->addNew<WDoubleSpinBox>();
+    cfsGranularitySpinBox_->setStyleClass("form-control");
+    cfsGranularitySpinBox_->setRange(0.01, 99.9);
+    cfsGranularitySpinBox_->setValue(0.75);
+    cfsGranularitySpinBox_->setDecimals(2);
+    cfsGranularitySpinBox_->setSingleStep(0.25);
+    cfsGranularitySpinBox_->changed().connect(this, &ProcessSchedulingCalculator::onInputEdited);
+    cfsGranularitySpinBox_->textInput().connect(this, &ProcessSchedulingCalculator::onInputEdited);
+    
+    cfsGroup->hide(); // Initially hide CFS inputs (only needs for CFS)
+    
+    auto ioDeviceGroup = cardBody->addNew<WContainerWidget>();
+    ioDeviceGroup->setStyleClass("mb-3");
+    ioDeviceGroup->setId("io-device-group"); // i/o devices container id
+    
+    auto ioDevicesLabel = ioDeviceGroup->addNew<WLabel>(" I/O Devices (0 = unlimited): ");
+    ioDevicesLabel->setStyleClass("form-label"); // i/o devices label
+    
+    // no. of i/o devices input box, process i does its i/o on device (i % devices)
+    ioDevicesSpinBox_ = ioDeviceGroup->addNew<WSpinBox>();
+    ioDevicesSpinBox_->setStyleClass("form-control mb-2");
+    ioDevicesSpinBox_->setRange(0, 64);
+    ioDevicesSpinBox_->setValue(0);
+    ioDevicesSpinBox_->changed().connect(this, &ProcessSchedulingCalculator::onInputEdited);
+    ioDevicesSpinBox_->textInput().connect(this, &ProcessSchedulingCalculator::onInputEdited);
+    
+    auto ioDisciplineLabel = ioDeviceGroup->addNew<WLabel>(" I/O Queue Discipline: ");
+    ioDisciplineLabel->setStyleClass("form-label"); // i/o discipline label
+    
+    // drop-down menu for the order of the requests waiting for a busy device (same order as IoConfig::Discipline)
+    ioDisciplineComboBox_ = ioDeviceGroup->addNew<WComboBox>();
+    ioDisciplineComboBox_->setStyleClass("form-select");
+    ioDisciplineComboBox_->addItem("First Come First Serve");
+    ioDisciplineComboBox_->addItem("Shortest I/O First");
+    ioDisciplineComboBox_->addItem("Highest Priority First");
+    ioDisciplineComboBox_->setCurrentIndex(0);
+    ioDisciplineComboBox_->changed().connect(this, &ProcessSchedulingCalculator::onInputEdited);
+    
+    ioDeviceGroup->hide(); // Initially hide i/o device inputs (only needs for IO)
+    
+    auto realTimeGroup = cardBody->addNew<WContainerWidget>();
+    realTimeGroup->setStyleClass("mb-3");
+    realTimeGroup->setId("real-time-group"); // release horizon container id
+    
+    auto realTimeHorizonLabel = realTimeGroup->addNew<WLabel>(" Release Horizon (0 = one hyperperiod, at most 100 periods): ");
+    realTimeHorizonLabel->setStyleClass("form-label"); // release horizon label
+    
+    // horizon input box, the periodic processes are released again every period until this time
+    realTimeHorizonSpinBox_ = realTimeGroup->addNew<WDoubleSpinBox>();
+    realTimeHorizonSpinBox_->setStyleClass("form-control");
+    realTimeHorizonSpinBox_->setRange(0.0, 99999.9);
+    realTimeHorizonSpinBox_->setValue(0.0);
+    realTimeHorizonSpinBox_->setDecimals(1);
+    realTimeHorizonSpinBox_->setSingleStep(10.0);
+    realTimeHorizonSpinBox_->changed().connect(this, &ProcessSchedulingCalculator::onInputEdited);
+    realTimeHorizonSpinBox_->textInput().connect(this, &ProcessSchedulingCalculator::onInputEdited);
+    
+    realTimeGroup->hide(); // Initially hide the horizon input (only needs for EDF & RMS)
+    
+    auto coreCountGroup = cardBody->addNew<WContainerWidget>();
+    coreCountGroup->setStyleClass("mb-3");
+    coreCountGroup->setId("cpu-group"); // cpu count & run queue container id
+    
+    auto coreCountLabel = coreCountGroup->addNew<WLabel>(" Number of CPUs: ");
+    coreCountLabel->setStyleClass("form-label"); // cpu count label
+    
+    // cpu count input box for specify the no. of cpus sharing the processes
+    coreCountSpinBox_ = coreCountGroup->addNew<WSpinBox>();
+    coreCountSpinBox_->setStyleClass("form-control mb-2");
+    coreCountSpinBox_->setRange(1, 4096);
+    coreCountSpinBox_->setValue(1);
+    coreCountSpinBox_->changed().connect(this, &ProcessSchedulingCalculator::onInputEdited);
+    coreCountSpinBox_->textInput().connect(this, &ProcessSchedulingCalculator::onInputEdited);
+    
+    auto runQueueLabel = coreCountGroup->addNew<WLabel>(" Run Queues: ");
+    runQueueLabel->setStyleClass("form-label"); // run queue label
+    
+    // drop-down menu for the run queue layout, only matters with more than one cpu
+    runQueueComboBox_ = coreCountGroup->addNew<WComboBox>();
+    runQueueComboBox_->setStyleClass("form-select");
+    runQueueComboBox_->addItem("Shared run queue");
+    runQueueComboBox_->addItem("Per-CPU run queues");
+    runQueueComboBox_->addItem("Per-CPU run queues + load balancing");
+    runQueueComboBox_->addItem("Per-CPU run queues + load balancing + work stealing");
+    runQueueComboBox_->setCurrentIndex(0);
+    runQueueComboBox_->changed().connect(this, &ProcessSchedulingCalculator::onInputEdited);
+    
+    auto switchCostGroup = cardBody->addNew<WContainerWidget>();
+    switchCostGroup->setStyleClass("mb-3");
+    switchCostGroup->setId("switch-cost-group"); // switch costs container id
+    
+    // a cost input box of every switch, the cpu spends that time before the process runs (0 = free switches)
+    auto addSwitchCost = [&](const std::string &label, const std::string &styleClass){
+        auto costLabel = switchCostGroup->addNew<WLabel>(label);
+        costLabel->setStyleClass("form-label"); // switch cost label
+        
+        auto costSpinBox = switchCostGroup->addNew<WDoubleSpinBox>();
+        costSpinBox->setStyleClass(styleClass);
+        costSpinBox->setRange(0.0, 99.9);
+        costSpinBox->setValue(0.0);
+        costSpinBox->setDecimals(2);
+        costSpinBox->setSingleStep(0.1);
+        costSpinBox->changed().connect(this, &ProcessSchedulingCalculator::onInputEdited);
+        costSpinBox->textInput().connect(this, &ProcessSchedulingCalculator::onInputEdited);
+        return costSpinBox;
+    };
+    contextSwitchSpinBox_ = addSwitchCost(" Context Switch Cost: ", "form-control mb-2");
+    migrationSpinBox_     = addSwitchCost(" CPU Migration Cost: ", "form-control mb-2");
+    cacheWarmupSpinBox_   = addSwitchCost(" Cache Warm-up Cost: ", "form-control");
+    
+    auto optimalGroup = cardBody->addNew<WContainerWidget>();
+    optimalGroup->setStyleClass("mb-3");
+    optimalGroup->setId("optimal-group"); // optimum comparison container id
+    
+    auto optimalLabel = optimalGroup->addNew<WLabel>(" Compare with the Optimum: ");
+    optimalLabel->setStyleClass("form-label"); // optimum comparison label
+    
+    // drop-down menu for the objective, whose best non-preemptive schedule is shown next to the results
+    // (same order as OptimalConfig::Objective, after "Off")
+    optimalComboBox_ = optimalGroup->addNew<WComboBox>();
+    optimalComboBox_->setStyleClass("form-select");
+    optimalComboBox_->addItem("Off");
+    optimalComboBox_->addItem("Total Completion Time");
+    optimalComboBox_->addItem("Weighted Completion Time (weight = priority)");
+    optimalComboBox_->addItem("Makespan");
+    optimalComboBox_->setCurrentIndex(0);
+    optimalComboBox_->changed().connect(this, &ProcessSchedulingCalculator::onInputEdited);
+    
+    auto liveModeGroup = cardBody->addNew<WContainerWidget>();
+    liveModeGroup->setStyleClass("form-check form-switch");
+    
+    // live mode toggle, results are recalculated in the background while the inputs are typed
+    liveModeCheckBox_ = liveModeGroup->addNew<WCheckBox>(" Live mode (recalculate while typing) ");
+    liveModeCheckBox_->setStyleClass("form-check-label");
+    liveModeCheckBox_->changed().connect(this, &ProcessSchedulingCalculator::onLiveModeChanged);
+    
+    // debounce timer of live mode, fires once the edits pause for a moment
+    liveTimer_ = addChild(std::make_unique<WTimer>());
+    liveTimer_->setSingleShot(true);
+    liveTimer_->setInterval(std::chrono::milliseconds(250));
+    liveTimer_->timeout().connect(this, &ProcessSchedulingCalculator::onLiveTimeout);
 }
 
 
@@ -222,15 +416,21 @@ inline void ProcessSchedulingCalculator::setupProcessInputTable(){
     headerRow->elementAt(3)->addNew<WText>("Inp_Out Time");
     headerRow->elementAt(4)->addNew<WText>("Execute Time");
     headerRow->elementAt(5)->addNew<WText>("Priority");
+    headerRow->elementAt(6)->addNew<WText>("Period");
+    headerRow->elementAt(7)->addNew<WText>("Deadline");
     
     headerRow->elementAt(3)->setId("inp-out-header");
     headerRow->elementAt(4)->setId("execute2-header");
     headerRow->elementAt(5)->setId("priority-header");
+    headerRow->elementAt(6)->setId("period-header");
+    headerRow->elementAt(7)->setId("deadline-header");
     headerRow->elementAt(3)->hide(); // initially hide because default is FCFS
     headerRow->elementAt(4)->hide(); // initially hide because default is FCFS
     headerRow->elementAt(5)->hide(); // initially hide because default is FCFS
+    headerRow->elementAt(6)->hide(); // initially hide because default is FCFS
+    headerRow->elementAt(7)->hide(); // initially hide because default is FCFS
     
-    for (short int i = 0; i <= 5; ++i) { // Style header
+    for (short int i = 0; i <= 7; ++i) { // Style header
         headerRow->elementAt(i)->setStyleClass("text-center rounded-pill bg-secondary text-white");
         // headerRow->elementAt(i)->setStyleClass("text-center");
     }
@@ -263,16 +463,24 @@ inline void ProcessSchedulingCalculator::setupControlButtons(){
 
 
 // set the output/result section for user outputs
-// combination of 2 section (grantt chart + statistics table and summury)
+// only the (hidden) container is created here, most sessions never calculate anything or only much later,
+// so the widgets inside are created by setupResultsWidgets() when the first results are shown
 inline void ProcessSchedulingCalculator::setupResultsSection(){
     
     resultsContainer_ = mainContainer_->addNew<WContainerWidget>();
     resultsContainer_->setStyleClass("row mb-4");
     resultsContainer_->setId("results-section");
     resultsContainer_->hide(); // initially hide the whole resultant container
+}
+
+
+// the widgets of the result section
+// combination of 2 section (grantt chart + statistics table and summury)
+inline void ProcessSchedulingCalculator::setupResultsWidgets(){
     
     setupGanttChart();
     setupStatisticsTable();
+    setupExportLinks();
 }
 
 
@@ -299,6 +507,20 @@ inline void ProcessSchedulingCalculator::setupGanttChart(){
     
     ganttChartText_ = ganttContainer_->addNew<WText>("demo grant text");
     ganttChartText_->setTextFormat(TextFormat::XHTML);
+    
+    // the chart itself is drawn by the browser from the packed segments of ganttData_ (see gantt.js)
+    ganttChart_ = ganttContainer_->addNew<WContainerWidget>();
+    ganttData_  = std::make_shared<GanttDataResource>(engine_, resultsVersion_, phaseTimings_);
+    require("gantt.js", "SchedulerGantt");
+    
+    // style of the gantt cells, so that each cell carries only its width, color & times
+    styleSheet().addRule(".gantt-process", "height: 40px; border: none; border-radius: 25px; text-align: center; "
+                                           "vertical-align: middle; font-size: 15px; font-weight: bold;");
+    styleSheet().addRule(".gantt-overhead", "background: repeating-linear-gradient(45deg, #adb5bd, #adb5bd 4px, "
+                                            "#dee2e6 4px, #dee2e6 8px); color: #495057;");
+    styleSheet().addRule(".gantt-time",  "height: 20px; border: none; background: transparent; position: relative;");
+    styleSheet().addRule(".gantt-time span:first-child", "padding-left: 5px;");
+    styleSheet().addRule(".gantt-time span:last-child", "padding-right: 5px;");
 }
 
 
@@ -343,8 +565,11 @@ inline void ProcessSchedulingCalculator::setupStatisticsTable(){
     statisticsContainer_ = summaryCard->addNew<WContainerWidget>();
     statisticsContainer_->setStyleClass("card-body text-center");
     
-    averageBurstTimeText_ = statisticsContainer_->addNew<WText>("demo avg bt");
-    averageBurstTimeText_->setStyleClass("mb-2"); // average throughput/burst time text
+    throughputText_ = statisticsContainer_->addNew<WText>("demo throughput");
+    throughputText_->setStyleClass("mb-2"); // throughput text
+    
+    cpuUtilizationText_ = statisticsContainer_->addNew<WText>("demo cpu utilization");
+    cpuUtilizationText_->setStyleClass("mb-2"); // cpu utilization text
     
     averageWaitingTimeText_ = statisticsContainer_->addNew<WText>("demo avg wt");
     averageWaitingTimeText_->setStyleClass("mb-2"); // average waititng time text
@@ -354,6 +579,51 @@ inline void ProcessSchedulingCalculator::setupStatisticsTable(){
     
     averageResponseTimeText_ = statisticsContainer_->addNew<WText>("demo avg rt");
     averageResponseTimeText_->setStyleClass("mb-2"); // average response time text
+    
+    waitingPercentilesText_ = statisticsContainer_->addNew<WText>("demo wt percentiles");
+    waitingPercentilesText_->setStyleClass("mb-2"); // waiting time percentiles text
+    
+    responsePercentilesText_ = statisticsContainer_->addNew<WText>("demo rt percentiles");
+    responsePercentilesText_->setStyleClass("mb-2"); // response time percentiles text
+    
+    deadlineText_ = statisticsContainer_->addNew<WText>();
+    deadlineText_->setStyleClass("mb-2"); // deadline misses & lateness text (EDF & RMS only)
+    
+    overheadText_ = statisticsContainer_->addNew<WText>();
+    overheadText_->setStyleClass("mb-2"); // switch overhead text (with switch costs only)
+    
+    optimalText_ = statisticsContainer_->addNew<WText>();
+    optimalText_->setStyleClass("mb-2"); // comparison with the optimum text (if selected)
+    
+    profileText_ = statisticsContainer_->addNew<WText>();
+    profileText_->setStyleClass("mb-2 small text-muted"); // profile of the session (profiling builds only)
+    profileText_->setTextFormat(TextFormat::XHTML);
+    profileText_->setHidden(not profilingEnabled);
+}
+
+
+// download links of the results, each download streams the results of the engine when it started
+inline void ProcessSchedulingCalculator::setupExportLinks(){
+    
+    auto exportSection = resultsContainer_->addNew<WContainerWidget>();
+    exportSection->setStyleClass("col-12 mb-4 text-center");
+    
+    auto addExportLink = [&](const std::string &label, const ScheduleExportResource::Format format,
+                             const ScheduleExportResource::Content content){
+        auto resource = std::make_shared<ScheduleExportResource>(engine_, format, content);
+        auto link = exportSection->addNew<WAnchor>(WLink(resource), label);
+        link->setStyleClass("btn btn-outline-primary btn-sm m-1");
+    };
+    addExportLink("Gantt Chart (CSV)",         ScheduleExportResource::CSV,  ScheduleExportResource::SEGMENTS);
+    addExportLink("Gantt Chart (JSON)",        ScheduleExportResource::JSON, ScheduleExportResource::SEGMENTS);
+    addExportLink("Process Statistics (CSV)",  ScheduleExportResource::CSV,  ScheduleExportResource::PROCESSES);
+    addExportLink("Process Statistics (JSON)", ScheduleExportResource::JSON, ScheduleExportResource::PROCESSES);
+    
+    if (profilingEnabled){
+        auto resource = std::make_shared<ProfileReportResource>(phaseTimings_, engine_);
+        auto link = exportSection->addNew<WAnchor>(WLink(resource), "Profile (JSON)");
+        link->setStyleClass("btn btn-outline-secondary btn-sm m-1");
+    }
 }
 
 
@@ -0,0 +1,7 @@
+#include "Results.hpp"
+
+
+// the scheduler_engine library of CMakeLists.txt: both engines are compiled (& optimized) once, here,
+// and the programs linked with it only declare them (SCHEDULER_ENGINE_LIBRARY, see the end of Results.hpp)
+template class BasicSchedulingEngine<double>;
+template class BasicSchedulingEngine<std::int64_t>;
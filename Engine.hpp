@@ -0,0 +1,479 @@
+#ifndef __Engine__
+#define __Engine__
+
+
+#include <vector>
+#include <deque>
+#include <string>
+#include <cstddef>
+#include <atomic>
+#include <cstdint>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <type_traits>
+#include <functional>
+#include <utility>
+#include <algorithm>
+
+#include "Profiling.hpp"
+#include "LatencyHistogram.hpp"
+
+
+// the engine is a template on its time type: double (the default, as typed in the ui), or an integer no. of
+// ticks (std::int64_t) for exact & reproducible results with cheaper comparisons, see TickResolution
+template <typename Time>
+struct TimeTraits {
+    static Time never(){ // later than any event
+        return  (std::numeric_limits<Time>::has_infinity) ? std::numeric_limits<Time>::infinity() :
+                                                            std::numeric_limits<Time>::max();
+    }
+    static Time fromDouble(const double &value){ // rounded to the nearest tick for integer times
+        if (not std::is_integral<Time>::value)  return static_cast<Time>(value);
+        if (value >= static_cast<double>(never()))  return never();
+        return static_cast<Time>(std::llround(value));
+    }
+    static Time positive(const double &value){ // same, but at least one tick for integer times
+        Time time = fromDouble(value);
+        return  (std::is_integral<Time>::value  and  time < 1) ? Time(1) : time;
+    }
+    static std::uint64_t sortKey(const Time &time){ // unsigned key in the same order as the times (radix sorts)
+        if (std::is_integral<Time>::value)  return static_cast<std::uint64_t>(time) ^ (std::uint64_t(1) << 63);
+        
+        double value = static_cast<double>(time) + 0.0; // -0 becomes +0
+        std::uint64_t bits;
+        std::memcpy(&bits, &value, sizeof(bits));
+        return  (bits >> 63) ? ~bits : bits | (std::uint64_t(1) << 63);
+    }
+};
+
+
+template <typename Time>
+struct BasicProcess { // structure for process information
+    int        id;
+    int        priority;
+    Time       arrivalTime;
+    Time       burstTime;
+    Time       burstTime2;
+    Time       waitingTime;
+    Time       turnaroundTime;
+    Time       completionTime;
+    Time       responseTime;
+    Time       remainingTime;
+    Time       remainingTime2;
+    Time       ioTime;
+    Time       period;          // EDF & RMS: released again every period (a periodic task), 0: released once
+    Time       deadline;        // EDF & RMS: relative deadline of each release, 0: the period (none if released once)
+    bool       started;
+    
+    BasicProcess() : id(0), priority(0), arrivalTime(0), burstTime(0), burstTime2(0),
+                     waitingTime(0), turnaroundTime(0), completionTime(0), responseTime(0),
+                     remainingTime(0), remainingTime2(0), ioTime(0), period(0), deadline(0), started(false) {}
+};
+using Process = BasicProcess<double>;
+
+
+template <typename Time>
+struct BasicGanttSegment { // segemnts for grant chart creation (colors are picked by the UI)
+    int          processId;
+    Time         startTime;
+    Time         endTime;
+    int          core;          // cpu (gantt lane) the segment ran on
+    bool         overhead;      // the cpu switched to the process (see SwitchCostConfig), it didn't run yet
+    
+    BasicGanttSegment(int id, Time start, Time end, int cpu = 0, bool switching = false)
+        : processId(id), startTime(start), endTime(end), core(cpu), overhead(switching) {}
+};
+using GanttSegment = BasicGanttSegment<double>;
+
+
+// converts processes between time units (double) and integer ticks, TicksPerUnit ticks make one unit
+template <std::int64_t TicksPerUnit>
+struct TickResolution {
+    static std::int64_t toTicks(const double &units){ return std::llround(units * TicksPerUnit); }
+    static double       toUnits(const std::int64_t &ticks){ return static_cast<double>(ticks) / TicksPerUnit; }
+    
+    static std::vector<BasicProcess<std::int64_t>> toTicks(const std::vector<Process> &processes){
+        std::vector<BasicProcess<std::int64_t>> converted(processes.size());
+        for (std::size_t i = 0; i < processes.size(); ++i){
+            converted[i].id          = processes[i].id;
+            converted[i].priority    = processes[i].priority;
+            converted[i].arrivalTime = toTicks(processes[i].arrivalTime);
+            converted[i].burstTime   = toTicks(processes[i].burstTime);
+            converted[i].burstTime2  = toTicks(processes[i].burstTime2);
+            converted[i].ioTime      = toTicks(processes[i].ioTime);
+            converted[i].period      = toTicks(processes[i].period);
+            converted[i].deadline    = toTicks(processes[i].deadline);
+        }
+        return converted;
+    }
+    static std::vector<Process> toUnits(const std::vector<BasicProcess<std::int64_t>> &processes){
+        std::vector<Process> converted(processes.size());
+        for (std::size_t i = 0; i < processes.size(); ++i){
+            const auto &process = processes[i];
+            auto &result = converted[i];
+            result.id       = process.id;
+            result.priority = process.priority;
+            result.started  = process.started;
+            result.arrivalTime    = toUnits(process.arrivalTime);     result.burstTime      = toUnits(process.burstTime);
+            result.burstTime2     = toUnits(process.burstTime2);      result.ioTime         = toUnits(process.ioTime);
+            result.waitingTime    = toUnits(process.waitingTime);     result.turnaroundTime = toUnits(process.turnaroundTime);
+            result.completionTime = toUnits(process.completionTime);  result.responseTime   = toUnits(process.responseTime);
+            result.remainingTime  = toUnits(process.remainingTime);   result.remainingTime2 = toUnits(process.remainingTime2);
+            result.period         = toUnits(process.period);          result.deadline       = toUnits(process.deadline);
+        }
+        return converted;
+    }
+};
+
+
+struct CpuConfig { // cpus of the simulated host
+    int   cores;                // no. of cpus
+    bool  perCoreQueues;        // one run queue per cpu, otherwise all cpus share one run queue
+    bool  loadBalancing;        // arrivals join the least loaded per-cpu queue, otherwise queue (index % cores)
+    bool  workStealing;         // an idle cpu with an empty queue steals from the longest per-cpu queue
+    
+    CpuConfig() : cores(1), perCoreQueues(false), loadBalancing(false), workStealing(false) {}
+};
+
+
+struct SwitchCostConfig { // cpu time lost whenever a cpu puts a process on it, before the process runs (all policies)
+    double  contextSwitch;    // the cpu ran another process last (or none yet)
+    double  migration;        // + the process ran on another cpu last (multi-cpu)
+    double  cacheWarmup;      // + the process ran before, so its cache went cold meanwhile (other process or cpu)
+    
+    SwitchCostConfig() : contextSwitch(0), migration(0), cacheWarmup(0) {}
+    
+    bool any() const { return  contextSwitch > 0  or  migration > 0  or  cacheWarmup > 0; }
+    bool operator==(const SwitchCostConfig &other) const {
+        return  contextSwitch == other.contextSwitch  and  migration == other.migration  and  cacheWarmup == other.cacheWarmup;
+    }
+};
+
+
+struct MlfqConfig { // multilevel feedback queue settings
+    int                  levels;          // no. of priority levels (1 - 64), level 0 is the highest
+    std::vector<double>  quanta;          // time allotment of each level, empty: time quantum * 2^level
+    double               boostInterval;   // every job moves back to level 0 this often, 0: never
+    
+    MlfqConfig() : levels(3), boostInterval(0) {}
+};
+
+
+struct ShareConfig { // proportional-share settings (STRIDE & LOTTERY), the tickets of a process are its priority
+    std::uint64_t  lotterySeed;     // seed of the draws of LOTTERY, the same seed gives the same schedule
+    
+    ShareConfig() : lotterySeed(1) {}
+};
+
+
+struct RealTimeConfig { // releases of the periodic tasks (EDF & RMS)
+    double  horizon;          // no periodic release at or after it, 0: one hyperperiod after the last first release,
+                              // but at most defaultPeriods of the longest period (co-prime periods make it huge)
+    
+    enum { defaultPeriods = 100 };
+    
+    RealTimeConfig() : horizon(0) {}
+    
+    // the horizon the engine uses for the processes (in their time unit)
+    template <typename Time>
+    double releaseHorizon(const std::vector<BasicProcess<Time>> &processes) const {
+        if (horizon > 0)  return horizon;
+        
+        double scale = 1, lastFirstRelease = 0, longestPeriod = 0; // scale: smallest power of 10 (upto 1000) that makes every period whole
+        for (const auto &process : processes){
+            if (process.period <= 0)  continue;
+            double period = static_cast<double>(process.period);
+            lastFirstRelease = std::max(lastFirstRelease, static_cast<double>(process.arrivalTime));
+            longestPeriod    = std::max(longestPeriod, period);
+            while (scale < 1000  and  std::fabs(period * scale - std::round(period * scale)) > 1e-6){ scale *= 10; }
+        }
+        // lcm of the periods, in 1/scale units, stops growing at the cap
+        const double cap = std::round(defaultPeriods * longestPeriod * scale);
+        std::int64_t hyperperiod = 1;
+        for (const auto &process : processes){
+            if (process.period <= 0  or  hyperperiod >= cap)  continue;
+            std::int64_t period = std::max<std::int64_t>(1, std::llround(static_cast<double>(process.period) * scale));
+            std::int64_t a = hyperperiod, b = period;
+            while (b){ std::int64_t r = a % b;  a = b;  b = r; } // a = gcd
+            hyperperiod = (static_cast<double>(hyperperiod / a) * period < cap) ? hyperperiod / a * period : static_cast<std::int64_t>(cap);
+        }
+        return  lastFirstRelease + hyperperiod / scale;
+    }
+    
+    // jobs (releases) of the processes up to the horizon, e.g. to refuse a run that would never end
+    template <typename Time>
+    double jobCount(const std::vector<BasicProcess<Time>> &processes) const {
+        double end = releaseHorizon(processes), jobs = 0;
+        for (const auto &process : processes){
+            double period = static_cast<double>(process.period), arrival = static_cast<double>(process.arrivalTime);
+            jobs += 1 + ((period > 0  and  end > arrival) ? std::ceil((end - arrival) / period) - 1 : 0);
+        }
+        return jobs;
+    }
+};
+
+
+struct DeadlineReport { // deadlines of the jobs (releases) of the last EDF / RMS run
+    std::uint64_t               jobs;             // releases of all the processes
+    std::uint64_t               deadlineMisses;   // jobs completed after their deadline
+    std::vector<std::uint64_t>  processMisses;    // misses of each process (in the order of the processes)
+    double                      maxLateness;      // completion - deadline of the latest job (negative: all in time)
+    LatencyHistogram            tardiness;        // max(0, lateness) of every job with a deadline
+    
+    DeadlineReport() : jobs(0), deadlineMisses(0), maxLateness(-std::numeric_limits<double>::infinity()) {}
+};
+
+
+struct Burst { // one phase of a process, on the cpu or on an i/o device
+    double  duration;
+    int     device;           // i/o device of the phase, -1: cpu
+    
+    Burst(double time = 0, int ioDevice = -1) : duration(time), device(ioDevice) {}
+};
+
+
+struct BurstTrace { // cpu & i/o phases of every process (IO), stored contiguously
+    std::vector<Burst>        bursts;     // phases of all processes, one process after the other
+    std::vector<std::size_t>  offsets;    // phases of process i: bursts[offsets[i]] .. bursts[offsets[i + 1] - 1]
+    
+    BurstTrace() : offsets(1, 0) {}
+    
+    std::size_t processCount() const { return offsets.size() - 1; }
+    void addProcess(const std::vector<Burst> &phases){ // phases of the next process
+        bursts.insert(bursts.end(), phases.begin(), phases.end());
+        offsets.push_back(bursts.size());
+    }
+};
+
+
+struct IoConfig { // i/o devices of the simulated host (IO)
+    enum Discipline { FCFS, SHORTEST_FIRST, PRIORITY };   // order of the requests waiting for a device
+    
+    int                      devices;       // no. of i/o devices, 0: unlimited (every i/o starts at once)
+    std::vector<Discipline>  disciplines;   // discipline of each device, missing ones are FCFS
+    
+    IoConfig() : devices(0) {}
+};
+
+
+struct CfsConfig { // completely fair scheduler settings
+    double  targetLatency;    // period in which every runnable process runs once (stretched when too many)
+    double  minGranularity;   // shortest slice, also the vruntime lead a new arrival needs to preempt
+    
+    CfsConfig() : targetLatency(6.0), minGranularity(0.75) {}
+};
+
+
+// fifo of process indices on a power-of-two ring buffer, doubled when full (O(1) push & pop)
+class RingQueue {
+    
+    std::vector<int>  buffer_;
+    std::size_t       head_;
+    std::size_t       size_;
+    
+    public:
+    RingQueue() : buffer_(16), head_(0), size_(0) {}
+    
+    bool        empty() const { return size_ == 0; }
+    std::size_t size()  const { return size_; }
+    
+    void push(const int &value){
+        if (size_ == buffer_.size()){ // unroll into a buffer twice as big
+            std::vector<int> buffer(buffer_.size() * 2);
+            for (std::size_t i = 0; i < size_; ++i){ buffer[i] = buffer_[(head_ + i) & (buffer_.size() - 1)]; }
+            buffer_.swap(buffer);
+            head_ = 0;
+        }
+        buffer_[(head_ + size_) & (buffer_.size() - 1)] = value;
+        ++size_;
+    }
+    int pop(){
+        int value = buffer_[head_];
+        head_ = (head_ + 1) & (buffer_.size() - 1);
+        --size_;
+        return value;
+    }
+};
+
+
+// stable LSD radix sort of (key, value) pairs by the key, 11 bits per pass
+// a pass whose digit is the same for every key is skipped, e.g. the high bits of times in a small range
+template <typename Value>
+inline void radixSortByKey(std::vector<std::pair<std::uint64_t, Value>> &items){
+    
+    const int digitBits = 11;
+    const std::uint64_t digitMask = (1 << digitBits) - 1;
+    if (items.size() < 2)  return;
+    
+    std::vector<std::pair<std::uint64_t, Value>> buffer(items.size());
+    std::vector<std::size_t> offsets(digitMask + 1);
+    
+    for (int shift = 0; shift < 64; shift += digitBits){
+        std::fill(offsets.begin(), offsets.end(), 0);
+        for (const auto &item : items){ ++offsets[(item.first >> shift) & digitMask]; }
+        if (offsets[(items[0].first >> shift) & digitMask] == items.size())  continue;
+        
+        std::size_t offset = 0;
+        for (auto &count : offsets){ std::size_t digitCount = count; count = offset; offset += digitCount; }
+        for (const auto &item : items){ buffer[offsets[(item.first >> shift) & digitMask]++] = item; }
+        items.swap(buffer);
+    }
+}
+
+
+// snapshot of a running simulation, taken at the event boundaries (top of the scheduling loop)
+// everything a policy needs to continue from that point is kept here
+template <typename Time>
+struct BasicSimulationState {
+    Time                            cpuCycle;              // cpu clock cycle
+    int                             arrivedProcessIndex;   // next position of the arrival order to admit
+    std::deque<int>                 readyQueue;            // indices of the arrived processes waiting for the cpu
+    std::vector<BasicProcess<Time>> processes;             // inputs + remaining times + results of each process
+    std::size_t                     segmentCount;          // gantt segments produced up to this point
+    int                             runningProcess;        // index of the process on the cpu, -1 if idle (SRTF only)
+    Time                            segmentStartTime;      // start time of the running process' open segment (SRTF only)
+    std::vector<int>                lastProcessOnCore;     // process index each cpu switched to last, -1: none yet
+    std::vector<int>                lastCoreOfProcess;     // cpu each process ran on last, -1: none yet (both: switch costs)
+    
+    BasicSimulationState() : cpuCycle(0), arrivedProcessIndex(0), segmentCount(0), runningProcess(-1), segmentStartTime(0) {}
+};
+using SimulationState = BasicSimulationState<double>;
+
+
+// runs the scheduling algorithms, independent of any UI
+// every run keeps checkpoints, so that a later run with only a few edited processes
+// resumes from the last checkpoint before the earliest edited arrival instead of t = 0
+// the settings of the configs (quanta, latencies, burst durations) are in the engine's time unit (ticks when integer)
+template <typename Time>
+class BasicSchedulingEngine {
+    
+    BasicSimulationState<Time>              state_;          // live state of the simulation (results after a run)
+    std::vector<BasicSimulationState<Time>> checkpoints_;    // snapshots of state_, in increasing cpu cycle
+    std::vector<BasicGanttSegment<Time>>    ganttSegments_;  // resultant gantt chart segments
+    std::size_t                  segmentOffset_;          // segments before ganttSegments_ (kept by the engine it is detached from)
+    std::size_t                  checkpointOffset_;       // same for checkpoints_
+    std::vector<int>             arrivalOrder_;           // process indices sorted by (arrival time, id)
+    std::string                  algorithm_;              // algorithm of the last run
+    Time                         timeQuantum_;            // time quantum of the last run
+    CpuConfig                    cpuConfig_;              // cpus of the last run
+    SwitchCostConfig             switchCosts_;            // overheads of the dispatches
+    MlfqConfig                   mlfqConfig_;             // levels of MLFQ
+    CfsConfig                    cfsConfig_;              // slices of CFS
+    IoConfig                     ioConfig_;               // i/o devices of IO
+    ShareConfig                  shareConfig_;            // seed of LOTTERY
+    RealTimeConfig               realTimeConfig_;         // horizon of EDF & RMS
+    BurstTrace                   burstTrace_;             // multi-burst phases of IO, unused when empty
+    std::size_t                  checkpointInterval_;     // no. of events between two checkpoints
+    std::size_t                  eventsSinceCheckpoint_;  // no. of events since the last checkpoint
+    const std::atomic<unsigned> *cancelToken_;            // when set, the run stops as soon as it differs from runToken_
+    unsigned                     runToken_;               // value of the cancel token this run belongs to
+    bool                         cancelled_;              // the last run was stopped before completion
+    bool                         checkpointing_;          // checkpoints are taken (needed for incremental runs only)
+    bool                         reusedResults_;          // the last run reused the previous results (not from t = 0)
+    bool                         keepSegments_;           // segments are kept in ganttSegments_ (besides the sink)
+    EngineCounters               counters_;               // hot-path events of the last run (profiling builds only)
+    DeadlineReport               deadlineReport_;         // deadline misses & lateness of the last EDF / RMS run
+    std::function<void(const BasicGanttSegment<Time> &)> segmentSink_;   // receives every segment once it ends
+    
+    // Simulation helpers
+    
+    void prepareArrivalOrder();            // reuses the previous order when it still holds
+    static bool sameInputs(const BasicProcess<Time> &p1, const BasicProcess<Time> &p2);
+    std::ptrdiff_t resumePoint(const std::vector<BasicProcess<Time>> &processes, const std::string &algorithm,
+                               const Time &timeQuantum, const CpuConfig &cpuConfig, std::vector<int> &editedProcesses) const;
+    static void restartEdited(BasicSimulationState<Time> &state, const std::vector<int> &editedProcesses,
+                              const std::vector<BasicProcess<Time>> &processes);
+    bool checkpoint();                     // called at every event boundary of the policies, false when cancelled
+    void admitArrivedProcesses();          // moves arrived processes into the ready queue
+    void runAlgorithm();                   // run'x'() by algorithm_
+    void addSegment(const int &processId, const Time &startTime, const Time &endTime, const int &core = 0,
+                    const bool &overhead = false);
+    Time switchCost(const int &processIndex, const int &core = 0);    // overhead of dispatching the process there
+    Time chargeSwitch(const int &processIndex, const int &core = 0);  // same, added to the chart from the cpu cycle
+    
+    // Algorithm implementations (continue from state_ until every process is completed)
+    
+    void runFCFS();
+    void runSJF();
+    void runPriority();
+    void runRoundRobin();
+    void runSRTF();
+    void runPRP();
+    void runIO();
+    void runMLFQ();
+    void runCFS();
+    void runProportionalShare();           // STRIDE & LOTTERY
+    void runRealTime();                    // EDF & RMS
+    void runSMP();                         // FCFS, SJF, PR, RR, SRTF & PRP on more than one cpu
+    
+    public:
+    BasicSchedulingEngine();
+    
+    // simulates the processes with the given algorithm and returns the index of the first
+    // gantt segment that differs from the previous run (0 when everything is recalculated)
+    // multi-cpu, IO, MLFQ, CFS, STRIDE, LOTTERY, EDF & RMS runs are always recalculated, and all but the first always
+    // run on a single cpu
+    std::size_t simulate(const std::vector<BasicProcess<Time>> &processes, const std::string &algorithm,
+                         const Time &timeQuantum, const CpuConfig &cpuConfig = CpuConfig());
+    void reset();                          // drops the results and the checkpoints
+    
+    // a run on another thread (e.g. live mode) without copying the engine: detach() hands over the settings & the
+    // one checkpoint the run of the processes resumes from, but none of the segments before it; simulate() runs
+    // on the detached engine, and attach() takes its results back (the engine must not run meanwhile)
+    BasicSchedulingEngine detach(const std::vector<BasicProcess<Time>> &processes, const std::string &algorithm,
+                                 const Time &timeQuantum, const CpuConfig &cpuConfig = CpuConfig()) const;
+    void attach(BasicSchedulingEngine &&detached);
+    
+    // one-off runs (e.g. the shards of a batch) can skip the checkpoints, then every run starts from t = 0
+    void setCheckpointing(const bool &enabled) { checkpointing_ = enabled; }
+    void setMlfqConfig(const MlfqConfig &mlfqConfig) { mlfqConfig_ = mlfqConfig; }
+    void setCfsConfig(const CfsConfig &cfsConfig) { cfsConfig_ = cfsConfig; }
+    void setIoConfig(const IoConfig &ioConfig) { ioConfig_ = ioConfig; }
+    void setShareConfig(const ShareConfig &shareConfig) { shareConfig_ = shareConfig; }
+    void setRealTimeConfig(const RealTimeConfig &realTimeConfig) { realTimeConfig_ = realTimeConfig; }
+    void setSwitchCostConfig(const SwitchCostConfig &switchCosts);    // other costs drop the checkpoints
+    
+    const SwitchCostConfig &switchCostConfig() const { return switchCosts_; }
+    
+    // IO takes the phases of the processes from the trace (when it has one entry per process),
+    // otherwise every process is burstTime on the cpu, ioTime on device (index % devices) & burstTime2 on the cpu
+    void setBurstTrace(const BurstTrace &burstTrace) { burstTrace_ = burstTrace; }
+    
+    // streams every gantt segment to the sink as soon as it ends (e.g. to a ScheduleWriter), without keeping
+    // them in ganttSegments() unless asked to; streamed segments can't be taken back, so while a sink is set
+    // every run starts from t = 0 and takes no checkpoints, an empty sink restores the default
+    void setSegmentSink(const std::function<void(const BasicGanttSegment<Time> &)> &sink, const bool &keepSegments = false);
+    
+    static bool supportsMultiCpu(const std::string &algorithm){
+        return  algorithm != "IO"  and  algorithm != "MLFQ"  and  algorithm != "CFS"  and  not isProportionalShare(algorithm)  and
+                not isRealTime(algorithm);
+    }
+    static bool isKnown(const std::string &algorithm){
+        return  algorithm == "FCFS"  or  algorithm == "SJF"  or  algorithm == "PR"  or  algorithm == "RR"  or  algorithm == "SRTF"  or
+                algorithm == "PRP"  or  algorithm == "IO"  or  algorithm == "MLFQ"  or  algorithm == "CFS"  or
+                isProportionalShare(algorithm)  or  isRealTime(algorithm);
+    }
+    static bool isProportionalShare(const std::string &algorithm){ // priorities are the tickets
+        return  algorithm == "STRIDE"  or  algorithm == "LOTTERY";
+    }
+    static bool isRealTime(const std::string &algorithm){ // periods & deadlines are used
+        return  algorithm == "EDF"  or  algorithm == "RMS";
+    }
+    
+    // a run started with a token value stops early (cancelled() is true) once the token changes,
+    // so that a background calculation of an outdated input can be abandoned
+    void setCancelToken(const std::atomic<unsigned> *cancelToken, const unsigned &runToken);
+    bool cancelled() const { return cancelled_; }
+    bool reusedResults() const { return reusedResults_; }  // resumed from a checkpoint, or nothing changed
+    
+    const std::vector<BasicProcess<Time>>      &processes()      const { return state_.processes; }
+    const std::vector<BasicGanttSegment<Time>> &ganttSegments()  const { return ganttSegments_; }
+    const EngineCounters                       &counters()       const { return counters_; }
+    const DeadlineReport                       &deadlineReport() const { return deadlineReport_; }
+};
+using SchedulingEngine     = BasicSchedulingEngine<double>;         // time in units, as typed in the ui
+using TickSchedulingEngine = BasicSchedulingEngine<std::int64_t>;   // time in integer ticks
+
+
+#endif // __Engine__
@@ -10,9 +10,16 @@ inline void ProcessSchedulingCalculator::onAlgorithmChanged(){
     
     short int algorithmIndex = algorithmComboBox_->currentIndex();
     auto timeQuantumInputBox = inputContainer_->findById("quantum-group");
+    auto cpuInputBox         = inputContainer_->findById("cpu-group");
+    auto mlfqInputBox        = inputContainer_->findById("mlfq-group");
+    auto cfsInputBox         = inputContainer_->findById("cfs-group");
+    auto ioDeviceInputBox    = inputContainer_->findById("io-device-group");
+    auto realTimeInputBox    = inputContainer_->findById("real-time-group");
     auto ioHeaderText        = inputContainer_->findById("inp-out-header");
     auto execute2HeaderText  = inputContainer_->findById("execute2-header");
     auto priorityHeaderText  = inputContainer_->findById("priority-header");
+    auto periodHeaderText    = inputContainer_->findById("period-header");
+    auto deadlineHeaderText  = inputContainer_->findById("deadline-header");
     
     switch (algorithmIndex){
         case 0: selectedAlgorithm_ = "FCFS";    break;
@@ -22,12 +29,36 @@ inline void ProcessSchedulingCalculator::onAlgorithmChanged(){
         case 4: selectedAlgorithm_ = "SRTF";    break;
         case 5: selectedAlgorithm_ = "PRP";     break;
         case 6: selectedAlgorithm_ = "IO";      break;
+        case 7: selectedAlgorithm_ = "MLFQ";    break;
+        case 8: selectedAlgorithm_ = "CFS";     break;
+        case 9: selectedAlgorithm_ = "EDF";     break;
+        case 10: selectedAlgorithm_ = "RMS";    break;
+        case 11: selectedAlgorithm_ = "STRIDE"; break;
+        case 12: selectedAlgorithm_ = "LOTTERY"; break;
     }
     
-    // show/hide quantum input for based on round-robin algotithm
-    if (selectedAlgorithm_ == "RR"){ timeQuantumInputBox->show(); } 
+    // show/hide quantum input for based on round-robin, MLFQ & proportional-share algotithms
+    if (selectedAlgorithm_ == "RR"  or  selectedAlgorithm_ == "MLFQ"  or  SchedulingEngine::isProportionalShare(selectedAlgorithm_)){
+        timeQuantumInputBox->show(); 
+    } 
     else { timeQuantumInputBox->hide(); }
     
+    if (selectedAlgorithm_ == "MLFQ"){ mlfqInputBox->show(); } 
+    else { mlfqInputBox->hide(); }
+    
+    if (selectedAlgorithm_ == "CFS"){ cfsInputBox->show(); } 
+    else { cfsInputBox->hide(); }
+    
+    if (selectedAlgorithm_ == "IO"){ ioDeviceInputBox->show(); } 
+    else { ioDeviceInputBox->hide(); }
+    
+    if (SchedulingEngine::isRealTime(selectedAlgorithm_)){ realTimeInputBox->show(); } 
+    else { realTimeInputBox->hide(); }
+    
+    // the i/o, MLFQ, CFS, proportional-share & real-time simulations run on a single cpu only
+    if (SchedulingEngine::supportsMultiCpu(selectedAlgorithm_)){ cpuInputBox->show(); } 
+    else { cpuInputBox->hide(); }
+    
     // show/hide execute2, io, priorty column based on algorithm change
     if (selectedAlgorithm_ == "IO"){ 
         ioHeaderText->show();  execute2HeaderText->show();  priorityHeaderText->show(); 
@@ -37,7 +68,8 @@ inline void ProcessSchedulingCalculator::onAlgorithmChanged(){
             processTable_->findById("priority-row" + std::to_string(i))->show();
         }
     }
-    else if (selectedAlgorithm_ == "PR"  or  selectedAlgorithm_ == "PRP"){ 
+    else if (selectedAlgorithm_ == "PR"  or  selectedAlgorithm_ == "PRP"  or  selectedAlgorithm_ == "CFS"  or
+             SchedulingEngine::isProportionalShare(selectedAlgorithm_)){ 
         ioHeaderText->hide();  execute2HeaderText->hide();  priorityHeaderText->show();
         for (short int i = 0; i < currentProcessCount_; ++i){
             processTable_->findById("inp-out-header" + std::to_string(i))->hide();
@@ -53,8 +85,16 @@ inline void ProcessSchedulingCalculator::onAlgorithmChanged(){
             processTable_->findById("priority-row" + std::to_string(i))->hide();
         }
     }
+    // period & deadline columns of the real-time policies
+    bool realTime = SchedulingEngine::isRealTime(selectedAlgorithm_);
+    periodHeaderText->setHidden(not realTime);  deadlineHeaderText->setHidden(not realTime);
+    for (short int i = 0; i < currentProcessCount_; ++i){
+        processTable_->findById("period-row" + std::to_string(i))->setHidden(not realTime);
+        processTable_->findById("deadline-row" + std::to_string(i))->setHidden(not realTime);
+    }
     
     clearResults(); // clear results whenever the algorithm is changed
+    onInputEdited(); // and recalculate them in live mode
 }
 
 
@@ -84,6 +124,7 @@ inline void ProcessSchedulingCalculator::onProcessCountChanged(){
     }
     
     updateProcessTable(newCount);
+    onInputEdited();
 }
 
 
@@ -117,46 +158,114 @@ inline void ProcessSchedulingCalculator::onCalculateClicked(){
     if (not validateInputs())  return; // if inputs are not validated then simply return
     timeQuantum_ = quantumSpinBox_->value();
     
-    // read data from table
-    for (short int i = 0; i < currentProcessCount_; ++i) {
-        auto ith_row = processTable_->rowAt(i + 1);
-        
-        processes_[i].id = i + 1; // set the process id
-        
-        auto arrivalEdit = static_cast<WDoubleSpinBox*>(ith_row->elementAt(1)->widget(0));
-        processes_[i].arrivalTime = arrivalEdit->value(); // read arrival time
-        
-        auto burstEdit = static_cast<WDoubleSpinBox*>(ith_row->elementAt(2)->widget(0));
-        processes_[i].burstTime = burstEdit->value(); // read burst time
-        
-        auto ioEdit = static_cast<WDoubleSpinBox*>(ith_row->elementAt(3)->widget(0));
-        processes_[i].ioTime = ioEdit->value(); // read io time
-        
-        auto burstEdit2 = static_cast<WDoubleSpinBox*>(ith_row->elementAt(4)->widget(0));
-        processes_[i].burstTime2 = burstEdit2->value(); // read burst time
-        
-        auto priorityEdit = static_cast<WSpinBox*>(ith_row->elementAt(5)->widget(0));
-        processes_[i].priority = priorityEdit->value(); // read priority
-        
-        // set other values
-        processes_[i].remainingTime  = processes_[i].burstTime;
-        processes_[i].remainingTime2 = processes_[i].burstTime2;
-    }
+    readProcessTable(); // read data from table
+    readCpuConfig();
+    readMlfqConfig();
+    readCfsConfig();
+    readIoConfig();
+    readRealTimeConfig();
+    readSwitchCostConfig();
+    engine_.setMlfqConfig(mlfqConfig_);
+    engine_.setCfsConfig(cfsConfig_);
+    engine_.setIoConfig(ioConfig_);
+    engine_.setRealTimeConfig(realTimeConfig_);
+    engine_.setSwitchCostConfig(switchCostConfig_);
+    ++(*liveGeneration_); // a running live calculation would overwrite these results
     
-    // calls the corosponding algorithms for specific caculations
-    if (selectedAlgorithm_ == "FCFS")    displayFCFSResults();
-    if (selectedAlgorithm_ == "SJF")     displaySJFResults();
-    if (selectedAlgorithm_ == "PR")      displayPriorityResults(); 
-    if (selectedAlgorithm_ == "RR")      displayRoundRobinResults();
-    if (selectedAlgorithm_ == "SRTF")    displaySRTFResults();
-    if (selectedAlgorithm_ == "PRP")     displayPRPResults();
-    if (selectedAlgorithm_ == "IO")      displayIOResults();
+    // simulate the selected algorithm, unchanged prefix of the previous results is reused by the engine
+    std::size_t firstChangedSegment;
+    {
+        PROFILE_PHASE(phaseTimings_, SIMULATION);
+        ScopedLatency latency(ServerMetrics::SIMULATION);
+        firstChangedSegment = engine_.simulate(processes_, selectedAlgorithm_, timeQuantum_, cpuConfig_);
+    }
+    ServerMetrics::instance().countCalculation(selectedAlgorithm_);
+    ServerMetrics::instance().count((engine_.reusedResults()) ? ServerMetrics::CACHE_HITS : ServerMetrics::CACHE_MISSES);
     
-    resultsContainer_->show();
+    showResults(firstChangedSegment);
     showAlertMessage("Calculations completed successfully !", true);
 }
 
 
+// enables server push for the background calculations, and calculates the current inputs
+inline void ProcessSchedulingCalculator::onLiveModeChanged(){
+    
+    enableUpdates(liveModeCheckBox_->isChecked()  or  optimalSearches_ > 0);
+    onInputEdited();
+}
+
+
+// an input value is changed, so in live mode the results are recalculated once the edits pause
+// a calculation that is still running for the older values is cancelled right away
+inline void ProcessSchedulingCalculator::onInputEdited(){
+    
+    if (not liveModeCheckBox_->isChecked())  return;
+    
+    ++(*liveGeneration_);
+    liveTimer_->start(); // restarts the debounce interval
+}
+
+
+// calculates the edited inputs on the background pool, without blocking the session or a thread of the server
+// the results are posted back to the session, only if no newer edit is made in the meantime
+inline void ProcessSchedulingCalculator::onLiveTimeout(){
+    
+    if (not validateInputs())  return;
+    timeQuantum_ = quantumSpinBox_->value();
+    readProcessTable();
+    readCpuConfig();
+    readMlfqConfig();
+    readCfsConfig();
+    readIoConfig();
+    readRealTimeConfig();
+    readSwitchCostConfig();
+    engine_.setMlfqConfig(mlfqConfig_);
+    engine_.setCfsConfig(cfsConfig_);
+    engine_.setIoConfig(ioConfig_);
+    engine_.setRealTimeConfig(realTimeConfig_);
+    engine_.setSwitchCostConfig(switchCostConfig_);
+    
+    // the background run works on copies, so the session can keep editing meanwhile; its engine is detached from
+    // the session's, with only the checkpoint it resumes from, and the segments before it stay here
+    auto liveEngine = std::make_shared<SchedulingEngine>(engine_.detach(processes_, selectedAlgorithm_, timeQuantum_, cpuConfig_));
+    auto processes  = processes_;
+    auto algorithm  = selectedAlgorithm_;
+    auto quantum    = timeQuantum_;
+    auto cpuConfig  = cpuConfig_;
+    auto generation = liveGeneration_->load();
+    auto liveGeneration = liveGeneration_; // keeps the token alive even if the session ends first
+    auto sessionId  = this->sessionId();
+    auto server     = WServer::instance();
+    
+    bool posted = BackgroundPool::instance().post([=](){
+        ServerMetrics::instance().count(ServerMetrics::LIVE_STARTED);
+        if (liveGeneration->load() != generation)  return; // outdated while it waited
+        liveEngine->setCancelToken(liveGeneration.get(), generation);
+        PhaseTimings liveTimings; // the session's timings are not touched off its thread
+        std::size_t firstChangedSegment;
+        {
+            PROFILE_PHASE(liveTimings, SIMULATION);
+            ScopedLatency latency(ServerMetrics::SIMULATION);
+            firstChangedSegment = liveEngine->simulate(processes, algorithm, quantum, cpuConfig);
+        }
+        if (liveEngine->cancelled())  return; // a newer edit is already on the way
+        ServerMetrics::instance().countCalculation(algorithm);
+        ServerMetrics::instance().count((liveEngine->reusedResults()) ? ServerMetrics::CACHE_HITS : ServerMetrics::CACHE_MISSES);
+        
+        server->post(sessionId, [=](){
+            if (liveGeneration->load() != generation)  return; // outdated results
+            
+            phaseTimings_.merge(liveTimings);
+            engine_.attach(std::move(*liveEngine)); // the session's engine is unchanged since, or the generation would be newer
+            showResults(firstChangedSegment);
+            triggerUpdate();
+        });
+    });
+    if (posted)  ServerMetrics::instance().count(ServerMetrics::LIVE_POSTED);
+    else  liveTimer_->start(); // the pool is full, tried again after the debounce interval
+}
+
+
 // clear the result and shows message
 inline void ProcessSchedulingCalculator::onClearClicked(){
     
@@ -165,5 +274,14 @@ inline void ProcessSchedulingCalculator::onClearClicked(){
 }
 
 
+// every request of the session passes here, wt handles the events & renders the response inside of it
+// so its time minus the other phases is the time spent by wt itself
+inline void ProcessSchedulingCalculator::notify(const Wt::WEvent &event){
+    
+    PROFILE_PHASE(phaseTimings_, REQUEST);
+    WApplication::notify(event);
+}
+
+
 
 #endif // __EventHandlers__
\ No newline at end of file
@@ -0,0 +1,223 @@
+#ifndef __Exports__
+#define __Exports__
+
+
+#include <Wt/WResource.h>
+#include <Wt/Http/Request.h>
+#include <Wt/Http/Response.h>
+
+#include <string>
+#include <vector>
+#include <memory>
+#include <ostream>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <type_traits>
+#include <algorithm>
+
+#include "Engine.hpp"
+#include "Profiling.hpp"
+#include "Metrics.hpp"
+
+
+// downloadable results of a session: the gantt segments or the per-process statistics, as CSV or JSON
+// the document is streamed a chunk of rows per request continuation, so even a huge result is never rendered as
+// one string; the rows are copied once, on the first request, so a recalculation of the session in the middle of
+// a download doesn't cut it short or mix two schedules: it finishes with the results it started with
+class ScheduleExportResource : public Wt::WResource {
+    
+    public:
+    enum Format  { CSV, JSON };
+    enum Content { SEGMENTS, PROCESSES };
+    
+    private:
+    struct Rows {                            // the results of a download (only those of its content)
+        std::vector<GanttSegment>  segments;
+        std::vector<Process>       processes;
+    };
+    struct Position {                        // where the next chunk continues
+        std::size_t                  row;
+        std::shared_ptr<const Rows>  rows;
+    };
+    
+    const SchedulingEngine  &engine_;          // results of the session (read with the session's update lock)
+    Format                   format_;
+    Content                  content_;
+    
+    static const std::size_t chunkRows = 4096; // rows written per response
+    
+    std::size_t rowCount(const Rows &rows) const {
+        return  (content_ == SEGMENTS) ? rows.segments.size() : rows.processes.size();
+    }
+    void writeHeader(std::ostream &out) const {
+        if (format_ == JSON){ out << "["; return; }
+        
+        if (content_ == SEGMENTS)  out << "process_id,start,end,cpu,overhead\n";
+        else  out << "process_id,priority,arrival,burst,burst2,io,completion,turnaround,waiting,response\n";
+    }
+    void writeRow(std::ostream &out, const Rows &rows, const std::size_t &row) const {
+        if (format_ == JSON  and  row > 0)  out << ",";
+        
+        if (content_ == SEGMENTS){
+            const auto &segment = rows.segments[row];
+            if (format_ == CSV){
+                out << segment.processId << ',' << segment.startTime << ',' << segment.endTime << ',' << segment.core << ','
+                    << segment.overhead << '\n';
+            } else {
+                out << "\n{\"processId\":" << segment.processId << ",\"start\":" << segment.startTime
+                    << ",\"end\":" << segment.endTime << ",\"cpu\":" << segment.core
+                    << ",\"overhead\":" << ((segment.overhead) ? "true" : "false") << "}";
+            }
+            return;
+        }
+        const auto &process = rows.processes[row];
+        if (format_ == CSV){
+            out << process.id << ',' << process.priority << ',' << process.arrivalTime << ',' << process.burstTime << ','
+                << process.burstTime2 << ',' << process.ioTime << ',' << process.completionTime << ','
+                << process.turnaroundTime << ',' << process.waitingTime << ',' << process.responseTime << '\n';
+        } else {
+            out << "\n{\"processId\":" << process.id << ",\"priority\":" << process.priority
+                << ",\"arrival\":" << process.arrivalTime << ",\"burst\":" << process.burstTime
+                << ",\"burst2\":" << process.burstTime2 << ",\"io\":" << process.ioTime
+                << ",\"completion\":" << process.completionTime << ",\"turnaround\":" << process.turnaroundTime
+                << ",\"waiting\":" << process.waitingTime << ",\"response\":" << process.responseTime << "}";
+        }
+    }
+    
+    public:
+    ScheduleExportResource(const SchedulingEngine &engine, const Format format, const Content content)
+        : engine_(engine), format_(format), content_(content){
+        
+        setTakesUpdateLock(true); // the rows are copied while the session can't recalculate them
+        setDispositionType(Wt::ContentDisposition::Attachment);
+        suggestFileName(std::string((content_ == SEGMENTS) ? "gantt" : "statistics") + ((format_ == CSV) ? ".csv" : ".json"));
+    }
+    ~ScheduleExportResource(){ beingDeleted(); }
+    
+    void handleRequest(const Wt::Http::Request &request, Wt::Http::Response &response) override {
+        
+        Wt::Http::ResponseContinuation *continuation = request.continuation();
+        Position position;
+        if (continuation)  position = Wt::cpp17::any_cast<Position>(continuation->data());
+        else {
+            auto rows = std::make_shared<Rows>();
+            if (content_ == SEGMENTS)  rows->segments = engine_.ganttSegments();
+            else  rows->processes = engine_.processes();
+            position = Position{ 0, std::move(rows) };
+        }
+        const Rows &rows = *position.rows;
+        
+        std::ostream &out = response.out();
+        out.precision(15);
+        if (not continuation){
+            response.setMimeType((format_ == CSV) ? "text/csv" : "application/json");
+            writeHeader(out);
+        }
+        std::size_t count = rowCount(rows), lastRow = std::min(count, position.row + chunkRows);
+        for (std::size_t row = position.row; row < lastRow; ++row){ writeRow(out, rows, row); }
+        
+        if (lastRow < count){
+            continuation = response.createContinuation();
+            continuation->setData(Position{ lastRow, position.rows });
+        }
+        else if (format_ == JSON){ out << "\n]\n"; }
+    }
+};
+
+
+// gantt segments of a session for the chart drawn by the browser (gantt.js), as packed little-endian columns:
+// segment count & first segment sent (uint32 each), then of the segments [from, count) the starts & ends (float64),
+// the process ids (int32), the cpus (uint16) & the flags (uint8, bit 0 = switch overhead), 23 bytes per segment
+// ?from=N sends only the segments from N on (the client keeps the ones before), but only while ?v= is still the
+// results version it was asked for, otherwise the client may hold other segments and gets all of them
+class GanttDataResource : public Wt::WResource {
+    
+    const SchedulingEngine  &engine_;          // results of the session (read with the session's update lock)
+    const unsigned          &resultsVersion_;  // changed by the session whenever the results change
+    PhaseTimings            &timings_;         // of the session, the packing is its gantt_data phase
+    std::string              buffer_;          // reused by every request (they hold the update lock)
+    
+    template <typename Integer>
+    static void put(char *&out, const Integer value){
+        auto bits = static_cast<typename std::make_unsigned<Integer>::type>(value);
+        for (std::size_t byte = 0; byte < sizeof(Integer); ++byte){ *out++ = static_cast<char>(bits >> (8 * byte)); }
+    }
+    static void put(char *&out, const double &value){
+        std::uint64_t bits;
+        std::memcpy(&bits, &value, sizeof(bits));
+        put(out, bits);
+    }
+    static std::size_t parameter(const Wt::Http::Request &request, const std::string &name){
+        const std::string *value = request.getParameter(name);
+        return  (value) ? std::strtoul(value->c_str(), nullptr, 10) : 0;
+    }
+    
+    public:
+    GanttDataResource(const SchedulingEngine &engine, const unsigned &resultsVersion, PhaseTimings &timings)
+        : engine_(engine), resultsVersion_(resultsVersion), timings_(timings){
+        
+        setTakesUpdateLock(true);
+    }
+    ~GanttDataResource(){ beingDeleted(); }
+    
+    void handleRequest(const Wt::Http::Request &request, Wt::Http::Response &response) override {
+        PROFILE_PHASE(timings_, GANTT_DATA);
+        
+        const auto &segments = engine_.ganttSegments();
+        std::size_t count = segments.size(), from = 0;
+        if (parameter(request, "v") == resultsVersion_)  from = std::min(parameter(request, "from"), count);
+        
+        buffer_.resize(8 + 23 * (count - from));
+        char *out = &buffer_[0];
+        put(out, static_cast<std::uint32_t>(count));
+        put(out, static_cast<std::uint32_t>(from));
+        for (std::size_t i = from; i < count; ++i){ put(out, static_cast<double>(segments[i].startTime)); }
+        for (std::size_t i = from; i < count; ++i){ put(out, static_cast<double>(segments[i].endTime)); }
+        for (std::size_t i = from; i < count; ++i){ put(out, static_cast<std::int32_t>(segments[i].processId)); }
+        for (std::size_t i = from; i < count; ++i){ put(out, static_cast<std::uint16_t>(segments[i].core)); }
+        for (std::size_t i = from; i < count; ++i){ put(out, static_cast<std::uint8_t>(segments[i].overhead)); }
+        
+        response.setMimeType("application/octet-stream");
+        response.addHeader("Cache-Control", "no-store");
+        response.out().write(buffer_.data(), buffer_.size());
+    }
+};
+
+
+// machine-readable profile of a session (see profileReport())
+class ProfileReportResource : public Wt::WResource {
+    
+    const PhaseTimings      &timings_;   // timings of the session
+    const SchedulingEngine  &engine_;    // counters of its last run
+    
+    public:
+    ProfileReportResource(const PhaseTimings &timings, const SchedulingEngine &engine)
+        : timings_(timings), engine_(engine){
+        
+        setTakesUpdateLock(true);
+        suggestFileName("profile.json");
+    }
+    ~ProfileReportResource(){ beingDeleted(); }
+    
+    void handleRequest(const Wt::Http::Request &, Wt::Http::Response &response) override {
+        response.setMimeType("application/json");
+        response.out() << profileReport(timings_, engine_.counters()) << "\n";
+    }
+};
+
+
+// GET /metrics of the server (not of a session), for prometheus to scrape
+class MetricsResource : public Wt::WResource {
+    
+    public:
+    ~MetricsResource(){ beingDeleted(); }
+    
+    void handleRequest(const Wt::Http::Request &, Wt::Http::Response &response) override {
+        response.setMimeType("text/plain; version=0.0.4");
+        ServerMetrics::instance().writePrometheus(response.out());
+    }
+};
+
+
+#endif // __Exports__
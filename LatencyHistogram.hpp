@@ -0,0 +1,78 @@
+#ifndef __LatencyHistogram__
+#define __LatencyHistogram__
+
+
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+#include <cmath>
+#include <algorithm>
+
+
+// log-linear (HDR style) histogram of non-negative times, for percentiles in one pass without sorting
+// every power of two is split into subBuckets equal buckets, so a percentile is within 1/128 of the
+// true value (relative); the counters grow only upto the largest bucket used, and two histograms merge by adding
+class LatencyHistogram {
+    
+    static const int subBuckets = 64;          // buckets per power of two
+    static const int minExponent = -16;        // values below 2^-16 are counted as 0
+    
+    std::vector<std::uint64_t>  counts_;       // counts_[0]: zeros, then the buckets in increasing value
+    std::uint64_t               totalCount_;
+    double                      max_;
+    
+    static std::size_t bucketOf(const double &value){
+        int exponent;
+        double mantissa = std::frexp(value, &exponent); // value = mantissa * 2^exponent, mantissa in [0.5, 1)
+        if (not (value > 0)  or  exponent <= minExponent)  return 0;
+        
+        int subBucket = static_cast<int>((mantissa - 0.5) * 2 * subBuckets);
+        return 1 + static_cast<std::size_t>(exponent - minExponent - 1) * subBuckets + std::min(subBucket, subBuckets - 1);
+    }
+    static double midpointOf(const std::size_t &bucket){
+        if (bucket == 0)  return 0;
+        int exponent  = static_cast<int>((bucket - 1) / subBuckets) + minExponent + 1;
+        int subBucket = static_cast<int>((bucket - 1) % subBuckets);
+        return std::ldexp(0.5 + (subBucket + 0.5) / (2 * subBuckets), exponent);
+    }
+    
+    public:
+    LatencyHistogram() : totalCount_(0), max_(0) {}
+    
+    void add(const double &value){
+        std::size_t bucket = bucketOf(value);
+        if (bucket >= counts_.size())  counts_.resize(bucket + 1, 0);
+        ++counts_[bucket];
+        ++totalCount_;
+        max_ = std::max(max_, value);
+    }
+    void merge(const LatencyHistogram &other){
+        if (other.counts_.size() > counts_.size())  counts_.resize(other.counts_.size(), 0);
+        for (std::size_t i = 0; i < other.counts_.size(); ++i){ counts_[i] += other.counts_[i]; }
+        totalCount_ += other.totalCount_;
+        max_ = std::max(max_, other.max_);
+    }
+    void clear(){ // keeps the counters, for reuse
+        std::fill(counts_.begin(), counts_.end(), 0);
+        totalCount_ = 0;
+        max_ = 0;
+    }
+    
+    std::uint64_t count() const { return totalCount_; }
+    double        max()   const { return max_; }
+    
+    // smallest value with at least the given fraction (0 - 1) of the values at or below it
+    double percentile(const double &fraction) const {
+        if (totalCount_ == 0)  return 0;
+        
+        std::uint64_t rank = std::max<std::uint64_t>(1, static_cast<std::uint64_t>(std::ceil(fraction * totalCount_))), seen = 0;
+        for (std::size_t bucket = 0; bucket < counts_.size(); ++bucket){
+            seen += counts_[bucket];
+            if (seen >= rank)  return std::min(midpointOf(bucket), max_);
+        }
+        return max_;
+    }
+};
+
+
+#endif // __LatencyHistogram__
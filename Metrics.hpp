@@ -0,0 +1,177 @@
+#ifndef __Metrics__
+#define __Metrics__
+
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <vector>
+
+
+// process-wide runtime metrics of the web server, exported in the prometheus text format (see MetricsResource)
+// every thread updates its own shard of counters, with plain relaxed stores as it is their only writer,
+// so the request & worker threads never contend; a scrape adds up the shards of all threads
+class ServerMetrics {
+    
+    public:
+    enum Counter { SESSIONS_STARTED, SESSIONS_ENDED, CACHE_HITS, CACHE_MISSES, LIVE_POSTED, LIVE_STARTED, COUNTER_COUNT };
+    enum Histogram { SIMULATION, RENDER, HISTOGRAM_COUNT };
+    
+    static const int algorithmCount = 13;
+    static const int bucketCount    = 14;  // + the +Inf bucket
+    
+    private:
+    struct Shard {
+        std::atomic<std::uint64_t>  counters[COUNTER_COUNT];
+        std::atomic<std::uint64_t>  calculations[algorithmCount + 1];             // the last one: unknown algorithm
+        std::atomic<std::uint64_t>  buckets[HISTOGRAM_COUNT][bucketCount + 1];
+        std::atomic<std::uint64_t>  sumNanoseconds[HISTOGRAM_COUNT];
+        
+        Shard(){
+            for (auto &counter : counters){ counter.store(0); }
+            for (auto &counter : calculations){ counter.store(0); }
+            for (auto &histogram : buckets){ for (auto &bucket : histogram){ bucket.store(0); } }
+            for (auto &sum : sumNanoseconds){ sum.store(0); }
+        }
+    };
+    
+    std::mutex                           shardsMutex_;   // guards shards_, taken once per thread & by the scrapes
+    std::vector<std::unique_ptr<Shard>>  shards_;        // one per thread that ever updated a metric (never freed)
+    
+    static const char *const *algorithms(){
+        static const char *const names[algorithmCount] = { "FCFS", "SJF", "PR", "RR", "SRTF", "PRP", "IO", "MLFQ", "CFS",
+                                                           "EDF", "RMS", "STRIDE", "LOTTERY" };
+        return names;
+    }
+    static const double *bucketBounds(){ // upper bounds in seconds
+        static const double bounds[bucketCount] = { 0.0001, 0.00025, 0.0005, 0.001, 0.0025, 0.005, 0.01,
+                                                    0.025, 0.05, 0.1, 0.25, 0.5, 1, 2.5 };
+        return bounds;
+    }
+    static void increment(std::atomic<std::uint64_t> &counter, const std::uint64_t &amount = 1){
+        counter.store(counter.load(std::memory_order_relaxed) + amount, std::memory_order_relaxed);
+    }
+    Shard &localShard(){
+        thread_local Shard *shard = nullptr;
+        if (not shard){
+            std::lock_guard<std::mutex> lock(shardsMutex_);
+            shards_.push_back(std::unique_ptr<Shard>(new Shard()));
+            shard = shards_.back().get();
+        }
+        return *shard;
+    }
+    ServerMetrics() {}
+    
+    public:
+    static ServerMetrics &instance(){
+        static ServerMetrics metrics;
+        return metrics;
+    }
+    
+    void count(const Counter counter){ increment(localShard().counters[counter]); }
+    void countCalculation(const std::string &algorithm){
+        int a = 0;
+        while (a < algorithmCount  and  algorithm != algorithms()[a]){ ++a; }
+        increment(localShard().calculations[a]);
+    }
+    void observe(const Histogram histogram, const std::uint64_t &nanoseconds){
+        Shard &shard = localShard();
+        int bucket = 0;
+        while (bucket < bucketCount  and  nanoseconds > bucketBounds()[bucket] * 1e9){ ++bucket; }
+        increment(shard.buckets[histogram][bucket]);
+        increment(shard.sumNanoseconds[histogram], nanoseconds);
+    }
+    
+    // all metrics in the prometheus text exposition format (version 0.0.4)
+    void writePrometheus(std::ostream &out){
+        
+        std::uint64_t counters[COUNTER_COUNT] = {}, calculations[algorithmCount + 1] = {};
+        std::uint64_t buckets[HISTOGRAM_COUNT][bucketCount + 1] = {}, sumNanoseconds[HISTOGRAM_COUNT] = {};
+        {
+            std::lock_guard<std::mutex> lock(shardsMutex_);
+            for (const auto &shard : shards_){
+                for (int c = 0; c < COUNTER_COUNT; ++c){ counters[c] += shard->counters[c].load(std::memory_order_relaxed); }
+                for (int a = 0; a <= algorithmCount; ++a){ calculations[a] += shard->calculations[a].load(std::memory_order_relaxed); }
+                for (int h = 0; h < HISTOGRAM_COUNT; ++h){
+                    for (int b = 0; b <= bucketCount; ++b){ buckets[h][b] += shard->buckets[h][b].load(std::memory_order_relaxed); }
+                    sumNanoseconds[h] += shard->sumNanoseconds[h].load(std::memory_order_relaxed);
+                }
+            }
+        }
+        // the shards are read one after the other, so a gauge (a difference) may be off by an update in flight
+        auto gauge = [](const std::uint64_t &up, const std::uint64_t &down){
+            return (up > down) ? up - down : 0;
+        };
+        
+        out << "# HELP scheduler_active_sessions Sessions currently open.\n"
+            << "# TYPE scheduler_active_sessions gauge\n"
+            << "scheduler_active_sessions " << gauge(counters[SESSIONS_STARTED], counters[SESSIONS_ENDED]) << "\n";
+        out << "# HELP scheduler_sessions_total Sessions opened since the server started.\n"
+            << "# TYPE scheduler_sessions_total counter\n"
+            << "scheduler_sessions_total " << counters[SESSIONS_STARTED] << "\n";
+        
+        out << "# HELP scheduler_calculations_total Completed calculations by scheduling policy.\n"
+            << "# TYPE scheduler_calculations_total counter\n";
+        for (int a = 0; a <= algorithmCount; ++a){
+            out << "scheduler_calculations_total{policy=\"" << ((a < algorithmCount) ? algorithms()[a] : "other") << "\"} "
+                << calculations[a] << "\n";
+        }
+        
+        const char *histogramNames[HISTOGRAM_COUNT] = { "scheduler_simulation_seconds", "scheduler_render_seconds" };
+        const char *histogramHelp[HISTOGRAM_COUNT]  = { "Time of the engine runs.",
+                                                        "Time of updating the gantt chart & the statistics of a result." };
+        for (int h = 0; h < HISTOGRAM_COUNT; ++h){
+            out << "# HELP " << histogramNames[h] << " " << histogramHelp[h] << "\n"
+                << "# TYPE " << histogramNames[h] << " histogram\n";
+            std::uint64_t cumulative = 0;
+            for (int b = 0; b <= bucketCount; ++b){
+                cumulative += buckets[h][b];
+                out << histogramNames[h] << "_bucket{le=\"";
+                if (b < bucketCount)  out << bucketBounds()[b];
+                else  out << "+Inf";
+                out << "\"} " << cumulative << "\n";
+            }
+            out << histogramNames[h] << "_sum " << sumNanoseconds[h] / 1e9 << "\n"
+                << histogramNames[h] << "_count " << cumulative << "\n";
+        }
+        
+        std::uint64_t lookups = counters[CACHE_HITS] + counters[CACHE_MISSES];
+        out << "# HELP scheduler_checkpoint_cache_lookups_total Calculations that could (hit) or could not (miss) "
+               "reuse the previous results.\n"
+            << "# TYPE scheduler_checkpoint_cache_lookups_total counter\n"
+            << "scheduler_checkpoint_cache_lookups_total{result=\"hit\"} " << counters[CACHE_HITS] << "\n"
+            << "scheduler_checkpoint_cache_lookups_total{result=\"miss\"} " << counters[CACHE_MISSES] << "\n";
+        out << "# HELP scheduler_checkpoint_cache_hit_ratio Share of the calculations that reused the previous results.\n"
+            << "# TYPE scheduler_checkpoint_cache_hit_ratio gauge\n"
+            << "scheduler_checkpoint_cache_hit_ratio " << ((lookups) ? double(counters[CACHE_HITS]) / lookups : 0) << "\n";
+        
+        out << "# HELP scheduler_live_queue_depth Live calculations waiting for a thread of the worker pool.\n"
+            << "# TYPE scheduler_live_queue_depth gauge\n"
+            << "scheduler_live_queue_depth " << gauge(counters[LIVE_POSTED], counters[LIVE_STARTED]) << "\n";
+    }
+};
+
+
+// observes the lifetime of its scope into a latency histogram of the server metrics
+class ScopedLatency {
+    
+    ServerMetrics::Histogram                histogram_;
+    std::chrono::steady_clock::time_point   start_;
+    
+    public:
+    explicit ScopedLatency(const ServerMetrics::Histogram histogram)
+        : histogram_(histogram), start_(std::chrono::steady_clock::now()) {}
+    ~ScopedLatency(){
+        auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start_);
+        ServerMetrics::instance().observe(histogram_, elapsed.count());
+    }
+    ScopedLatency(const ScopedLatency &) = delete;
+    ScopedLatency &operator=(const ScopedLatency &) = delete;
+};
+
+
+#endif // __Metrics__
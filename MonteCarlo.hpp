@@ -0,0 +1,212 @@
+#ifndef __MonteCarlo__
+#define __MonteCarlo__
+
+
+#include <vector>
+#include <string>
+#include <random>
+#include <cmath>
+#include <cstdint>
+#include <algorithm>
+
+#include "Engine.hpp"
+#include "Batch.hpp"
+#include "Statistics.hpp"
+
+
+struct WorkloadDistribution { // random workloads of a Monte Carlo evaluation
+    enum Shape { CONSTANT, UNIFORM, EXPONENTIAL };   // of a time with the given mean (uniform: 0 - 2 * mean)
+    
+    int     processCount;        // processes of each workload
+    double  meanInterarrival;    // time between two arrivals (exponential: poisson arrivals)
+    Shape   interarrivalShape;
+    double  meanBurst;           // cpu burst of a process
+    Shape   burstShape;
+    double  meanBurst2;          // second cpu burst & the i/o before it, 0 = none (IO only)
+    double  meanIo;
+    int     maxPriority;         // priorities are uniform in 1 - maxPriority
+    double  resolution;          // the times are rounded to it, & a burst takes at least one of it
+    
+    WorkloadDistribution() : processCount(50), meanInterarrival(5), interarrivalShape(EXPONENTIAL), meanBurst(4),
+                             burstShape(EXPONENTIAL), meanBurst2(0), meanIo(0), maxPriority(10), resolution(0.1) {}
+    
+    // one workload of the distribution, into processes (its capacity is reused)
+    template <typename Random>
+    void sample(Random &random, std::vector<Process> &processes) const {
+        
+        auto draw = [&](const Shape shape, const double &mean){
+            if (mean <= 0  or  shape == CONSTANT)  return std::max(0.0, mean);
+            if (shape == UNIFORM)  return std::uniform_real_distribution<double>(0, 2 * mean)(random);
+            return std::exponential_distribution<double>(1 / mean)(random);
+        };
+        auto round = [this](const double &time){
+            return  (resolution > 0) ? std::round(time / resolution) * resolution : time;
+        };
+        std::uniform_int_distribution<int> priority(1, std::max(1, maxPriority));
+        
+        processes.resize(std::max(0, processCount));
+        double arrival = 0;
+        for (std::size_t i = 0; i < processes.size(); ++i){
+            Process &process = processes[i];
+            if (i > 0)  arrival += draw(interarrivalShape, meanInterarrival);
+            process = Process();
+            process.id          = i + 1;
+            process.arrivalTime = round(arrival);
+            process.burstTime   = std::max(resolution, round(draw(burstShape, meanBurst)));
+            process.priority    = priority(random);
+            if (meanBurst2 > 0){
+                process.ioTime     = round(draw(burstShape, meanIo));
+                process.burstTime2 = std::max(resolution, round(draw(burstShape, meanBurst2)));
+            }
+        }
+    }
+};
+
+
+struct MonteCarloConfig {
+    std::size_t    replications;   // workloads simulated
+    std::uint64_t  seed;           // replication r always gets the same workload, whatever the no. of threads
+    double         confidence;     // level of the intervals (0 - 1)
+    unsigned       threadCount;    // 0 = all cpus
+    
+    MonteCarloConfig() : replications(1000), seed(1), confidence(0.95), threadCount(0) {}
+};
+
+
+struct MetricEstimate { // mean of a metric over the replications, with its confidence interval
+    double  mean;
+    double  standardDeviation;   // of the replications
+    double  halfWidth;           // of the interval: mean +- halfWidth
+    
+    MetricEstimate() : mean(0), standardDeviation(0), halfWidth(0) {}
+    
+    double low()  const { return mean - halfWidth; }
+    double high() const { return mean + halfWidth; }
+};
+
+
+struct MonteCarloResult { // results of simulateMonteCarlo()
+    enum Metric { WAITING, TURNAROUND, RESPONSE, WAITING_P99, THROUGHPUT, UTILIZATION, MAKESPAN, METRIC_COUNT };
+    
+    std::size_t     replications;
+    double          confidence;
+    MetricEstimate  metrics[METRIC_COUNT];   // averages of a workload, e.g. metrics[WAITING]: its average waiting time
+    
+    MonteCarloResult() : replications(0), confidence(0) {}
+    
+    static const char *name(const Metric metric){
+        static const char *names[METRIC_COUNT] = { "average waiting time", "average turnaround time",
+                                                   "average response time", "p99 waiting time", "throughput",
+                                                   "cpu utilization", "makespan" };
+        return names[metric];
+    }
+};
+
+
+namespace MonteCarlo {
+    
+    // x with P(Z <= x) = p of the standard normal distribution
+    inline double normalQuantile(const double &p){
+        double low = -40, high = 40;
+        for (int i = 0; i < 200; ++i){ // bisection, exact to the double resolution
+            double middle = (low + high) / 2;
+            if (0.5 * std::erfc(-middle / std::sqrt(2.0)) < p)  low = middle;
+            else  high = middle;
+        }
+        return (low + high) / 2;
+    }
+    
+    // x with P(T <= x) = p of the student t distribution, exact for 1 & 2 degrees of freedom,
+    // otherwise by the Cornish-Fisher expansion around the normal one (within 1 % from 3 degrees of freedom on)
+    inline double studentQuantile(const double &p, const double &degreesOfFreedom){
+        const double pi = 3.14159265358979323846;
+        if (degreesOfFreedom <= 1)  return std::tan(pi * (p - 0.5));
+        if (degreesOfFreedom <= 2)  return (2 * p - 1) / std::sqrt(2 * p * (1 - p));
+        
+        double z = normalQuantile(p), n = degreesOfFreedom;
+        double z3 = z * z * z, z5 = z3 * z * z, z7 = z5 * z * z;
+        return  z + (z3 + z) / (4 * n) + (5 * z5 + 16 * z3 + 3 * z) / (96 * n * n)
+                  + (3 * z7 + 19 * z5 + 17 * z3 - 15 * z) / (384 * n * n * n);
+    }
+    
+    // seed of a replication, the replications of near seeds are still independent streams (splitmix64)
+    inline std::uint64_t replicationSeed(const std::uint64_t &seed, const std::uint64_t &replication){
+        std::uint64_t x = seed + (replication + 1) * 0x9e3779b97f4a7c15ULL;
+        x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ULL;
+        x = (x ^ (x >> 27)) * 0x94d049bb133111ebULL;
+        return x ^ (x >> 31);
+    }
+}
+
+
+// evaluates a policy under stochastic load: simulates many seeded random workloads of the distribution in parallel
+// on a work-stealing pool, and estimates the mean of every metric with a confidence interval
+// every worker reuses its own engine (a copy of the prototype, so it has its configs), workload & statistics buffers,
+// so after the first replications the workers neither allocate nor share anything but their rows of the results
+// the metrics of a replication are those of the summary (ScheduleStatistics), the p99 is taken from its histogram
+inline MonteCarloResult simulateMonteCarlo(const WorkloadDistribution &distribution, const std::string &algorithm,
+                                           const double &timeQuantum, const MonteCarloConfig &config = MonteCarloConfig(),
+                                           const CpuConfig &cpuConfig = CpuConfig(),
+                                           const SchedulingEngine &prototype = SchedulingEngine()){
+    
+    struct Worker {
+        SchedulingEngine      engine;
+        std::vector<Process>  workload;
+        ScheduleStatistics    statistics;   // of the current replication
+    };
+    WorkStealingPool pool(config.threadCount);
+    std::vector<Worker> workers(pool.threadCount(), Worker{ prototype, {}, {} });
+    for (auto &worker : workers){ worker.engine.setCheckpointing(false); }
+    
+    const int metricCount = MonteCarloResult::METRIC_COUNT;
+    int cores = (SchedulingEngine::supportsMultiCpu(algorithm)) ? std::max(1, cpuConfig.cores) : 1;
+    bool secondBursts = (algorithm == "IO"), realTime = SchedulingEngine::isRealTime(algorithm);
+    
+    // the metrics of each replication, a row each, reduced in replication order afterwards (same sums every time)
+    std::vector<double> samples(config.replications * metricCount, 0);
+    pool.run(config.replications, [&](const unsigned w, const std::size_t replication){
+        Worker &worker = workers[w];
+        std::mt19937_64 random(MonteCarlo::replicationSeed(config.seed, replication));
+        distribution.sample(random, worker.workload);
+        worker.engine.simulate(worker.workload, algorithm, timeQuantum, cpuConfig);
+        
+        ScheduleStatistics &statistics = worker.statistics;
+        statistics.clear();
+        for (const auto &process : worker.engine.processes()){ statistics.add(process, secondBursts); }
+        if (realTime)  statistics.busyTimeFromChart(worker.engine.ganttSegments());
+        
+        double *row = &samples[replication * metricCount];
+        row[MonteCarloResult::WAITING]     = statistics.averageWaitingTime();
+        row[MonteCarloResult::TURNAROUND]  = statistics.averageTurnaroundTime();
+        row[MonteCarloResult::RESPONSE]    = statistics.averageResponseTime();
+        row[MonteCarloResult::WAITING_P99] = statistics.waitingTimes.percentile(0.99);
+        row[MonteCarloResult::THROUGHPUT]  = statistics.throughput();
+        row[MonteCarloResult::UTILIZATION] = statistics.cpuUtilization(cores);
+        row[MonteCarloResult::MAKESPAN]    = statistics.makespan();
+    });
+    
+    MonteCarloResult result;
+    result.replications = config.replications;
+    result.confidence   = config.confidence;
+    if (config.replications == 0)  return result;
+    
+    // welford's mean & variance, then the student t interval of the mean
+    double n = config.replications;
+    double t = (n > 1) ? MonteCarlo::studentQuantile(0.5 + config.confidence / 2, n - 1) : 0;
+    for (int m = 0; m < metricCount; ++m){
+        double mean = 0, squares = 0;
+        for (std::size_t r = 0; r < config.replications; ++r){
+            double value = samples[r * metricCount + m], delta = value - mean;
+            mean    += delta / (r + 1);
+            squares += delta * (value - mean);
+        }
+        MetricEstimate &estimate = result.metrics[m];
+        estimate.mean              = mean;
+        estimate.standardDeviation = (n > 1) ? std::sqrt(squares / (n - 1)) : 0;
+        estimate.halfWidth         = t * estimate.standardDeviation / std::sqrt(n);
+    }
+    return result;
+}
+
+
+#endif // __MonteCarlo__
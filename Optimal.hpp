@@ -0,0 +1,366 @@
+#ifndef __Optimal__
+#define __Optimal__
+
+
+#include <vector>
+#include <atomic>
+#include <mutex>
+#include <cstdint>
+#include <limits>
+#include <functional>
+#include <algorithm>
+
+#include "Engine.hpp"
+#include "Batch.hpp"
+
+
+struct OptimalConfig { // what solveOptimal() minimizes & how long it may search
+    enum Objective { TOTAL_COMPLETION, WEIGHTED_COMPLETION, MAKESPAN };
+    
+    Objective      objective;
+    bool           secondBursts;   // a process runs burstTime, waits ioTime (on its own device), then runs burstTime2 (IO)
+    std::uint64_t  nodeLimit;      // search nodes of all threads, the best schedule found so far is returned beyond it
+    unsigned       threadCount;    // 0 = all cpus
+    
+    OptimalConfig() : objective(TOTAL_COMPLETION), secondBursts(false), nodeLimit(2000000), threadCount(0) {}
+};
+
+
+struct OptimalSchedule { // result of solveOptimal()
+    double                     value;        // objective of the schedule below
+    double                     lowerBound;   // no schedule is better than it (= value, once proven optimal)
+    bool                       optimal;      // the search finished within the node limit
+    std::uint64_t              nodes;        // search nodes visited
+    std::vector<GanttSegment>  segments;     // the schedule, in time order
+    
+    OptimalSchedule() : value(0), lowerBound(0), optimal(false), nodes(0) {}
+};
+
+
+// objective value of completed processes (e.g. the results of a policy), comparable to OptimalSchedule::value
+// the weight of a process is its priority (at least 1), like the CFS weights & the stride tickets
+inline double scheduleObjective(const std::vector<Process> &processes, const OptimalConfig::Objective objective){
+    double value = 0;
+    for (const auto &process : processes){
+        if (objective == OptimalConfig::MAKESPAN)  value = std::max(value, process.completionTime);
+        else if (objective == OptimalConfig::WEIGHTED_COMPLETION)  value += std::max(1, process.priority) * process.completionTime;
+        else  value += process.completionTime;
+    }
+    return value;
+}
+
+
+// branch & bound over the non-preemptive single cpu schedules of a workload
+// a node fixes the next cpu burst to run; only active schedules are searched (a burst is never started after another
+// one could have completed first), which always contain an optimal one, and a node is pruned once its lower bound
+// reaches the best schedule found (the incumbent, shared by all threads)
+class BranchAndBound {
+    
+    struct Job {
+        double  release;     // arrival time
+        double  burst;
+        double  io;          // wait between the bursts
+        double  burst2;      // 0 = a single burst
+        double  weight;
+    };
+    struct Step { int job;  double start; double end;  double ready; };   // ready: of the job before the step
+    struct Search {          // state of one thread, changed & undone along its depth first path
+        std::vector<int>     stage;       // bursts of each job done (0 - 2)
+        std::vector<double>  ready;       // earliest start of the next burst of each job
+        std::vector<Step>    path;        // bursts fixed so far
+        std::vector<std::vector<int>>  next;   // candidates of each depth of the path
+        double               time;        // the cpu is free from then on
+        double               cost;        // objective of the finished jobs (makespan: latest completion)
+        int                  finished;
+        std::uint64_t        nodes;       // not yet added to nodes_
+        double               cutBound;    // lowest bound of the nodes left unexplored at the node limit
+        std::vector<std::pair<double, double>>  ratios;     // buffers of lowerBound()
+        std::vector<std::pair<double, double>>  releases;
+        std::vector<double>                     remaining;
+    };
+    
+    std::vector<Job>             jobs_;
+    OptimalConfig                config_;
+    std::atomic<double>          incumbent_;       // value of the best schedule found
+    std::mutex                   bestMutex_;       // guards best_ & bestValue_
+    std::vector<Step>            best_;            // the best schedule found
+    double                       bestValue_;
+    std::atomic<std::uint64_t>   nodes_;
+    
+    enum { splitDepth = 4,       // the search is split into the subtrees of the nodes at most this deep,
+           tasksPerThread = 8 }; // as soon as there are this many per thread
+    
+    bool hasSecondBurst(const int &j) const { return  config_.secondBursts  and  jobs_[j].burst2 > 0; }
+    double currentBurst(const Search &search, const int &j) const {
+        return  (search.stage[j] == 0) ? jobs_[j].burst : jobs_[j].burst2;
+    }
+    // work & waits left after the current burst of the job
+    double tail(const Search &search, const int &j) const {
+        return  (search.stage[j] == 0  and  hasSecondBurst(j)) ? jobs_[j].io + jobs_[j].burst2 : 0;
+    }
+    double remainingWork(const Search &search, const int &j) const {
+        return  currentBurst(search, j) + ((search.stage[j] == 0  and  hasSecondBurst(j)) ? jobs_[j].burst2 : 0);
+    }
+    bool done(const Search &search, const int &j) const {
+        return  search.stage[j] == ((hasSecondBurst(j)) ? 2 : 1);
+    }
+    
+    // the cost of the finished jobs + a bound of the unfinished ones:
+    // every job completes no earlier than its own next burst & tail run without waiting (1), and not earlier than in
+    // a schedule of all the left work from the earliest ready time on, without waits & releases (2: the
+    // weighted shortest processing time order is optimal then, for the makespan just the sum);
+    // for the total completion, the left work of every job may even be preempted but keeps its ready time (3: the
+    // shortest remaining work first is optimal then)
+    double lowerBound(Search &search) const {
+        
+        double chains = search.cost, earliest = std::numeric_limits<double>::infinity(), work = 0;
+        search.ratios.clear();
+        search.releases.clear();
+        for (int j = 0; j < static_cast<int>(jobs_.size()); ++j){
+            if (done(search, j))  continue;
+            
+            double start = std::max(search.time, search.ready[j]), chainEnd = start + currentBurst(search, j) + tail(search, j);
+            if (config_.objective == OptimalConfig::MAKESPAN)  chains = std::max(chains, chainEnd);
+            else  chains += jobs_[j].weight * chainEnd;
+            earliest = std::min(earliest, start);
+            work += remainingWork(search, j);
+            search.ratios.emplace_back(remainingWork(search, j), jobs_[j].weight);
+            search.releases.emplace_back(start, remainingWork(search, j));
+        }
+        if (search.ratios.empty())  return search.cost;
+        if (config_.objective == OptimalConfig::MAKESPAN)  return std::max(chains, earliest + work);
+        if (config_.objective == OptimalConfig::TOTAL_COMPLETION)  return std::max(chains, shortestRemainingBound(search));
+        
+        std::sort(search.ratios.begin(), search.ratios.end(), [](const std::pair<double, double> &a,
+                                                                 const std::pair<double, double> &b){
+            return  a.first * b.second < b.first * a.second; // smaller work / weight first
+        });
+        double relaxed = search.cost, completion = earliest;
+        for (const auto &job : search.ratios){ completion += job.first;  relaxed += job.second * completion; }
+        return std::max(chains, relaxed);
+    }
+    
+    double shortestRemainingBound(Search &search) const {
+        
+        std::sort(search.releases.begin(), search.releases.end());
+        auto &heap = search.remaining;   // min heap of the left work of the released jobs
+        heap.clear();
+        
+        double bound = search.cost, time = search.releases.front().first;
+        std::size_t next = 0;
+        while (next < search.releases.size()  or  not heap.empty()){
+            if (heap.empty())  time = std::max(time, search.releases[next].first);
+            while (next < search.releases.size()  and  search.releases[next].first <= time){
+                heap.push_back(search.releases[next++].second);
+                std::push_heap(heap.begin(), heap.end(), std::greater<double>());
+            }
+            double release = (next < search.releases.size()) ? search.releases[next].first :
+                                                                std::numeric_limits<double>::infinity();
+            if (time + heap.front() <= release){ // the shortest one completes before the next release
+                time += heap.front();
+                bound += time;
+                std::pop_heap(heap.begin(), heap.end(), std::greater<double>());
+                heap.pop_back();
+            } else {                                // or runs until it, the heap order stays as the front only shrinks
+                heap.front() -= release - time;
+                time = release;
+            }
+        }
+        return bound;
+    }
+    
+    // bursts that may run next (active schedules), the most promising first
+    void candidates(const Search &search, std::vector<int> &next) const {
+        
+        double firstEnd = std::numeric_limits<double>::infinity();
+        for (int j = 0; j < static_cast<int>(jobs_.size()); ++j){
+            if (not done(search, j))  firstEnd = std::min(firstEnd, std::max(search.time, search.ready[j]) + currentBurst(search, j));
+        }
+        next.clear();
+        for (int j = 0; j < static_cast<int>(jobs_.size()); ++j){
+            if (done(search, j))  continue;
+            double start = std::max(search.time, search.ready[j]);
+            if (start < firstEnd  or  start + currentBurst(search, j) <= firstEnd)  next.push_back(j);
+        }
+        // completion objectives: highest weight per unit of work first; makespan: longest i/o & burst after it first
+        auto key = [&](const int &j){
+            if (config_.objective == OptimalConfig::MAKESPAN)  return -tail(search, j);
+            return  currentBurst(search, j) / jobs_[j].weight;
+        };
+        std::stable_sort(next.begin(), next.end(), [&](const int &j1, const int &j2){ return key(j1) < key(j2); });
+    }
+    
+    // runs the next burst of the job, returns what undo() needs
+    Step apply(Search &search, const int &j) const {
+        Step step{ j, std::max(search.time, search.ready[j]), 0, search.ready[j] };
+        step.end = step.start + currentBurst(search, j);
+        search.path.push_back(step);
+        search.time = step.end;
+        search.ready[j] = step.end + ((search.stage[j] == 0) ? jobs_[j].io : 0);
+        ++search.stage[j];
+        if (done(search, j)){
+            ++search.finished;
+            if (config_.objective == OptimalConfig::MAKESPAN)  search.cost = std::max(search.cost, step.end);
+            else  search.cost += jobs_[j].weight * step.end;
+        }
+        return step;
+    }
+    void undo(Search &search, const Step &step, const double &time, const double &cost) const {
+        const int &j = step.job;
+        if (done(search, j))  --search.finished;
+        --search.stage[j];
+        search.ready[j] = step.ready;
+        search.time = time;
+        search.cost = cost;
+        search.path.pop_back();
+    }
+    
+    // a complete schedule, kept if it is the best one so far (of equal ones, the first in job order, whatever
+    // thread finds it first)
+    void offer(const Search &search){
+        auto jobOrder = [](const Step &s1, const Step &s2){ return s1.job < s2.job; };
+        
+        std::lock_guard<std::mutex> lock(bestMutex_);
+        if (search.cost < bestValue_  or  (search.cost == bestValue_  and
+            std::lexicographical_compare(search.path.begin(), search.path.end(), best_.begin(), best_.end(), jobOrder))){
+            best_      = search.path;
+            bestValue_ = search.cost;
+            incumbent_.store(bestValue_);
+        }
+    }
+    
+    void countNode(Search &search){
+        if (++search.nodes == 1024){ nodes_ += search.nodes;  search.nodes = 0; }
+    }
+    bool overLimit() const { return nodes_.load(std::memory_order_relaxed) >= config_.nodeLimit; }
+    
+    void depthFirst(Search &search){
+        
+        countNode(search);
+        if (search.finished == static_cast<int>(jobs_.size())){ offer(search);  return; }
+        
+        double bound = lowerBound(search);
+        if (bound >= incumbent_.load() - 1e-9)  return; // can't improve
+        if (overLimit()){ search.cutBound = std::min(search.cutBound, bound);  return; }
+        
+        std::vector<int> &next = search.next[search.path.size()];
+        candidates(search, next);
+        for (const auto &j : next){
+            double time = search.time, cost = search.cost;
+            Step step = apply(search, j);
+            depthFirst(search);
+            undo(search, step, time, cost);
+        }
+    }
+    
+    // the paths (jobs in order) of the roots of the subtrees the threads search, in depth first order: the tree is
+    // expanded level by level upto splitDepth, or until there are enough subtrees that a thread done with its own
+    // takes another one instead of waiting for the largest; pruned nodes are left out
+    std::vector<std::vector<int>> splitSubtrees(const unsigned &threads){
+        
+        std::vector<std::vector<int>> level(1), deeper;
+        std::vector<int> next;
+        for (int depth = 0; depth < splitDepth  and  level.size() < std::size_t(tasksPerThread) * threads; ++depth){
+            deeper.clear();
+            for (const auto &path : level){
+                Search search = newSearch();
+                for (const auto &j : path){ apply(search, j); }
+                if (search.finished == static_cast<int>(jobs_.size())){ deeper.push_back(path);  continue; } // a leaf
+                
+                ++nodes_;
+                if (lowerBound(search) >= incumbent_.load() - 1e-9)  continue;
+                candidates(search, next);
+                for (const auto &j : next){
+                    deeper.push_back(path);
+                    deeper.back().push_back(j);
+                }
+            }
+            level.swap(deeper);
+        }
+        return level;
+    }
+    
+    Search newSearch() const {
+        Search search;
+        search.stage.assign(jobs_.size(), 0);
+        search.next.resize(2 * jobs_.size() + 1);
+        search.ready.resize(jobs_.size());
+        for (std::size_t j = 0; j < jobs_.size(); ++j){ search.ready[j] = jobs_[j].release; }
+        search.time = 0;
+        search.cost = 0;
+        search.finished = 0;
+        search.nodes = 0;
+        search.cutBound = std::numeric_limits<double>::infinity();
+        return search;
+    }
+    
+    public:
+    BranchAndBound(const std::vector<Process> &processes, const OptimalConfig &config)
+        : config_(config), incumbent_(std::numeric_limits<double>::infinity()),
+          bestValue_(std::numeric_limits<double>::infinity()), nodes_(0) {
+        
+        for (const auto &process : processes){
+            double weight = (config.objective == OptimalConfig::WEIGHTED_COMPLETION) ? std::max(1, process.priority) : 1;
+            jobs_.push_back(Job{ process.arrivalTime, process.burstTime, process.ioTime, process.burstTime2, weight });
+        }
+    }
+    
+    OptimalSchedule solve(const std::vector<Process> &processes){
+        
+        OptimalSchedule result;
+        if (jobs_.empty())  return result;
+        
+        // two greedy schedules are the first incumbents: the most promising candidate every time, and the most
+        // promising one of those that can start right away (non-delay, e.g. non-preemptive SJF for the total completion)
+        for (int nonDelay = 0; nonDelay < 2; ++nonDelay){
+            Search greedy = newSearch();
+            std::vector<int> next;
+            while (greedy.finished < static_cast<int>(jobs_.size())){
+                candidates(greedy, next);
+                int pick = next.front();
+                for (const auto &j : next){
+                    if (nonDelay  and  std::max(greedy.time, greedy.ready[j]) < std::max(greedy.time, greedy.ready[pick]))  pick = j;
+                }
+                apply(greedy, pick);
+            }
+            offer(greedy);
+        }
+        Search root = newSearch();
+        double rootBound = lowerBound(root);
+        
+        // every subtree is a task of the pool, the incumbent prunes across the threads; a worker takes its newest
+        // task first, so the tasks are in reverse order & every worker starts with its most promising subtree
+        WorkStealingPool pool(config_.threadCount);
+        std::vector<std::vector<int>> subtrees = splitSubtrees(pool.threadCount());
+        std::vector<double> cutBounds(subtrees.size(), std::numeric_limits<double>::infinity());
+        pool.run(subtrees.size(), [&](const unsigned, const std::size_t task){
+            Search search = newSearch();
+            for (const auto &j : subtrees[subtrees.size() - 1 - task]){ apply(search, j); }
+            depthFirst(search);
+            nodes_ += search.nodes;
+            cutBounds[task] = search.cutBound;
+        });
+        
+        result.value      = bestValue_;
+        result.nodes      = nodes_.load();
+        result.lowerBound = result.value;
+        for (const auto &bound : cutBounds){ result.lowerBound = std::min(result.lowerBound, bound); }
+        result.optimal    = (result.lowerBound == result.value);
+        result.lowerBound = std::max(result.lowerBound, std::min(rootBound, result.value));
+        
+        for (const auto &step : best_){ result.segments.emplace_back(processes[step.job].id, step.start, step.end); }
+        return result;
+    }
+};
+
+
+// best non-preemptive single cpu schedule of the processes for the objective, or the best one found within the
+// node limit with a bound on the optimum; e.g. how far the results of a policy are from the optimum
+// (see scheduleObjective()), a preemptive policy may even beat it
+inline OptimalSchedule solveOptimal(const std::vector<Process> &processes, const OptimalConfig &config = OptimalConfig()){
+    BranchAndBound search(processes, config);
+    return search.solve(processes);
+}
+
+
+#endif // __Optimal__
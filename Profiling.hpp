@@ -0,0 +1,115 @@
+#ifndef __Profiling__
+#define __Profiling__
+
+
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <sstream>
+#include <algorithm>
+
+
+// build with -DSCHEDULER_PROFILING to time the phases of a calculation and to count the engine's hot-path events
+// otherwise the PROFILE_x() macros expand to nothing, and the timings & the counters simply stay 0
+#ifdef SCHEDULER_PROFILING
+const bool profilingEnabled = true;
+#else
+const bool profilingEnabled = false;
+#endif
+
+
+struct EngineCounters { // hot-path events of the last run (counted in profiling builds only)
+    std::uint64_t  events;           // scheduling decisions (event boundaries of the policies)
+    std::uint64_t  dispatches;       // processes put on a cpu, one per gantt segment
+    std::uint64_t  preemptions;      // unfinished processes taken off a cpu back into a ready queue
+    std::uint64_t  queueHighWater;   // most processes waiting in one ready queue at once (FCFS keeps none)
+    std::uint64_t  allocations;      // checkpoint copies & growths of the gantt segment buffer
+    
+    EngineCounters() : events(0), dispatches(0), preemptions(0), queueHighWater(0), allocations(0) {}
+};
+
+
+struct PhaseTimings { // wall time of the phases of a session's calculations
+    enum Phase { SIMULATION, GANTT_UPDATE, GANTT_DATA, STATISTICS, REQUEST, PHASE_COUNT };
+    
+    struct Timing {
+        std::uint64_t  calls;
+        std::uint64_t  totalNanoseconds;
+        std::uint64_t  maxNanoseconds;
+        
+        Timing() : calls(0), totalNanoseconds(0), maxNanoseconds(0) {}
+    };
+    Timing timings[PHASE_COUNT];
+    
+    static const char *name(const Phase phase){
+        static const char *names[PHASE_COUNT] = { "simulation", "gantt_update", "gantt_data", "statistics", "request" };
+        return names[phase];
+    }
+    void record(const Phase phase, const std::uint64_t &nanoseconds){
+        Timing &timing = timings[phase];
+        ++timing.calls;
+        timing.totalNanoseconds += nanoseconds;
+        timing.maxNanoseconds    = std::max(timing.maxNanoseconds, nanoseconds);
+    }
+    void merge(const PhaseTimings &other){
+        for (int phase = 0; phase < PHASE_COUNT; ++phase){
+            timings[phase].calls            += other.timings[phase].calls;
+            timings[phase].totalNanoseconds += other.timings[phase].totalNanoseconds;
+            timings[phase].maxNanoseconds    = std::max(timings[phase].maxNanoseconds, other.timings[phase].maxNanoseconds);
+        }
+    }
+};
+
+
+// records the lifetime of its scope as one call of the phase
+class ScopedPhaseTimer {
+    
+    PhaseTimings                                        &timings_;
+    PhaseTimings::Phase                                  phase_;
+    std::chrono::steady_clock::time_point                start_;
+    
+    public:
+    ScopedPhaseTimer(PhaseTimings &timings, const PhaseTimings::Phase phase)
+        : timings_(timings), phase_(phase), start_(std::chrono::steady_clock::now()) {}
+    ~ScopedPhaseTimer(){
+        auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start_);
+        timings_.record(phase_, elapsed.count());
+    }
+    ScopedPhaseTimer(const ScopedPhaseTimer &) = delete;
+    ScopedPhaseTimer &operator=(const ScopedPhaseTimer &) = delete;
+};
+
+
+#define PROFILE_CONCAT_(a, b)  a##b
+#define PROFILE_CONCAT(a, b)   PROFILE_CONCAT_(a, b)
+
+#ifdef SCHEDULER_PROFILING
+#define PROFILE_PHASE(timings, phase)       ScopedPhaseTimer PROFILE_CONCAT(phaseTimer_, __LINE__)((timings), PhaseTimings::phase)
+#define PROFILE_COUNT(counter)              (++(counter))
+#define PROFILE_HIGH_WATER(counter, value)  ((counter) = std::max<std::uint64_t>((counter), (value)))
+#else
+#define PROFILE_PHASE(timings, phase)
+#define PROFILE_COUNT(counter)              ((void)0)
+#define PROFILE_HIGH_WATER(counter, value)  ((void)0)
+#endif
+
+
+// machine-readable report of a session, as a JSON object
+inline std::string profileReport(const PhaseTimings &timings, const EngineCounters &counters){
+    
+    std::ostringstream report;
+    report << "{\"profiling\":" << ((profilingEnabled) ? "true" : "false") << ",\"phases\":{";
+    for (int phase = 0; phase < PhaseTimings::PHASE_COUNT; ++phase){
+        const auto &timing = timings.timings[phase];
+        report << ((phase) ? "," : "") << "\"" << PhaseTimings::name(static_cast<PhaseTimings::Phase>(phase)) << "\":{"
+               << "\"calls\":" << timing.calls << ",\"total_ns\":" << timing.totalNanoseconds
+               << ",\"max_ns\":" << timing.maxNanoseconds << "}";
+    }
+    report << "},\"counters\":{\"events\":" << counters.events << ",\"dispatches\":" << counters.dispatches
+           << ",\"preemptions\":" << counters.preemptions << ",\"queue_high_water\":" << counters.queueHighWater
+           << ",\"allocations\":" << counters.allocations << "}}";
+    return report.str();
+}
+
+
+#endif // __Profiling__
@@ -1,33 +1,436 @@
-
 #ifndef __Results__
 #define __Results__
 
-#include "Classes.hpp"
+#include "Engine.hpp"
+#include "Batch.hpp"
+#include "MonteCarlo.hpp"
+#include "Optimal.hpp"
+#include "ScheduleFormat.hpp"
+#include "ScheduleIndex.hpp"
 #include <algorithm>
+#include <limits>
+#include <set>
+#include <queue>
+#include <random>
 
 
-// it calculates the FIST-COME-FIRST-SERVE result
-inline void ProcessSchedulingCalculator::displayFCFSResults(){
+template <typename Time>
+inline BasicSchedulingEngine<Time>::BasicSchedulingEngine()
+    : segmentOffset_(0), checkpointOffset_(0), timeQuantum_(0), checkpointInterval_(16), eventsSinceCheckpoint_(0),
+      cancelToken_(nullptr), runToken_(0), cancelled_(false), checkpointing_(true), reusedResults_(false),
+      keepSegments_(true) {}
+
+
+// drops the previous results, the next simulation starts again from t = 0
+template <typename Time>
+inline void BasicSchedulingEngine<Time>::reset(){
+    
+    state_ = BasicSimulationState<Time>();
+    checkpoints_.clear();
+    ganttSegments_.clear();
+    segmentOffset_ = checkpointOffset_ = 0;
+    algorithm_.clear(); // arrivalOrder_ is kept, the next run may have the same arrivals
+}
+
+
+// the following runs check the token at every event, and stop when it no longer matches runToken
+template <typename Time>
+inline void BasicSchedulingEngine<Time>::setCancelToken(const std::atomic<unsigned> *cancelToken, const unsigned &runToken){
+    
+    cancelToken_ = cancelToken;
+    runToken_    = runToken;
+}
+
+
+// runs with a sink take no checkpoints, so the run after it (with or without a sink) starts again from t = 0
+template <typename Time>
+inline void BasicSchedulingEngine<Time>::setSegmentSink(const std::function<void(const BasicGanttSegment<Time> &)> &sink,
+                                                        const bool &keepSegments){
+    
+    segmentSink_  = sink;
+    keepSegments_ = keepSegments  or  not sink;
+}
+
+
+// the checkpoints & the results were simulated with the old costs, so the next run starts again from t = 0
+template <typename Time>
+inline void BasicSchedulingEngine<Time>::setSwitchCostConfig(const SwitchCostConfig &switchCosts){
+    
+    if (switchCosts == switchCosts_)  return;
+    switchCosts_ = switchCosts;
+    checkpoints_.clear();
+}
+
+
+// same inputs of a process means, it behaves exactly the same upto its arrival
+template <typename Time>
+inline bool BasicSchedulingEngine<Time>::sameInputs(const BasicProcess<Time> &p1, const BasicProcess<Time> &p2){
+    return  p1.arrivalTime == p2.arrivalTime  and  p1.burstTime == p2.burstTime  and
+            p1.burstTime2  == p2.burstTime2   and  p1.ioTime    == p2.ioTime     and
+            p1.priority    == p2.priority     and  p1.period    == p2.period     and
+            p1.deadline    == p2.deadline;
+}
+
+
+// the checkpoint (index) a run of the processes resumes from, when only some processes are edited since the last
+// run (same algorithm, quantum & process count): the last one before the earliest edited arrival
+// -1: the run starts from t = 0, checkpoints_.size(): nothing is edited, the results stay the same
+template <typename Time>
+inline std::ptrdiff_t BasicSchedulingEngine<Time>::resumePoint(const std::vector<BasicProcess<Time>> &processes,
+                                                               const std::string &algorithm, const Time &timeQuantum,
+                                                               const CpuConfig &cpuConfig, std::vector<int> &editedProcesses) const {
+    
+    editedProcesses.clear();
+    bool multiCpu = cpuConfig.cores > 1  and  supportsMultiCpu(algorithm);
+    
+    // only single cpu runs have checkpoints (multi-cpu runs are always recalculated), results of a cancelled run
+    // can't be reused
+    if (cancelled_  or  multiCpu  or  segmentSink_  or  algorithm != algorithm_  or  timeQuantum != timeQuantum_  or
+        checkpoints_.empty()  or  processes.size() != state_.processes.size())  return -1;
+    
+    // nothing can differ before the earliest (old or new) arrival of an edited process
+    Time editHorizon = TimeTraits<Time>::never();
+    for (int i = 0, n = processes.size(); i < n; ++i){
+        if (not sameInputs(processes[i], state_.processes[i])){
+            editHorizon = std::min({editHorizon, processes[i].arrivalTime, state_.processes[i].arrivalTime});
+            editedProcesses.push_back(i);
+        }
+    }
+    if (editedProcesses.empty())  return checkpoints_.size(); // same results as before
+    
+    // last checkpoint where none of the edited processes has arrived yet
+    std::ptrdiff_t resume = checkpoints_.size() - 1;
+    while (resume >= 0  and  not (checkpoints_[resume].cpuCycle < editHorizon)){ --resume; }
+    return resume;
+}
+
+
+// the edited processes are not arrived yet in a checkpoint before the resume point, so they just start with their
+// new values there
+template <typename Time>
+inline void BasicSchedulingEngine<Time>::restartEdited(BasicSimulationState<Time> &state, const std::vector<int> &editedProcesses,
+                                                       const std::vector<BasicProcess<Time>> &processes){
+    for (int i : editedProcesses){
+        state.processes[i] = processes[i];
+        state.processes[i].remainingTime  = processes[i].burstTime;
+        state.processes[i].remainingTime2 = processes[i].burstTime2;
+        state.processes[i].started = false;
+    }
+}
+
+
+// simulates the given processes with the given algorithm
+// if only some processes are edited since the last run, then the simulation resumes from the last checkpoint
+// taken before the earliest edited arrival (see resumePoint())
+template <typename Time>
+inline std::size_t BasicSchedulingEngine<Time>::simulate(const std::vector<BasicProcess<Time>> &processes, const std::string &algorithm,
+                                              const Time &timeQuantum, const CpuConfig &cpuConfig){
+    
+    std::vector<int> editedProcesses;
+    std::ptrdiff_t resume = resumePoint(processes, algorithm, timeQuantum, cpuConfig, editedProcesses);
+    bool multiCpu = cpuConfig.cores > 1  and  supportsMultiCpu(algorithm);
+    cancelled_      = false;
+    reusedResults_  = false;
+    counters_       = EngineCounters();
+    deadlineReport_ = DeadlineReport();
+    
+    if (resume == static_cast<std::ptrdiff_t>(checkpoints_.size())){ // same results as before
+        reusedResults_ = true;
+        return segmentOffset_ + ganttSegments_.size();
+    }
+    if (resume >= 0){
+        checkpoints_.erase(checkpoints_.begin() + resume + 1, checkpoints_.end()); // later checkpoints are outdated
+        for (auto &state : checkpoints_){ restartEdited(state, editedProcesses, processes); }
+        state_ = checkpoints_.back();
+        eventsSinceCheckpoint_ = 0;
+        prepareArrivalOrder();
+        
+        std::size_t firstChangedSegment = state_.segmentCount; // segments before it are still valid
+        reusedResults_ = true;
+        ganttSegments_.resize(firstChangedSegment - segmentOffset_, BasicGanttSegment<Time>(0, 0, 0));
+        
+        runAlgorithm();
+        return firstChangedSegment;
+    }
+    
+    // full simulation from t = 0
+    reset();
+    algorithm_   = algorithm;
+    timeQuantum_ = timeQuantum;
+    cpuConfig_   = cpuConfig;
+    
+    state_.processes = processes;
+    for (auto &process : state_.processes){
+        process.remainingTime  = process.burstTime;
+        process.remainingTime2 = process.burstTime2;
+        process.started = false;
+    }
+    prepareArrivalOrder();
+    
+    // keep the no. of checkpoints (each one is a copy of all processes) proportional to the events
+    checkpointInterval_    = std::max<std::size_t>(16, processes.size() / 8);
+    eventsSinceCheckpoint_ = checkpointInterval_; // always checkpoint the initial state
+    
+    // never checkpoint multi-cpu, IO, MLFQ, CFS, STRIDE, LOTTERY, EDF & RMS runs, the cpus, the devices, the levels,
+    // the vruntimes, the passes, the random draws & the jobs are not a part of SimulationState
+    if (multiCpu  or  algorithm_ == "IO"  or  algorithm_ == "MLFQ"  or  algorithm_ == "CFS"  or  isProportionalShare(algorithm_)  or
+        isRealTime(algorithm_)  or  not checkpointing_  or  segmentSink_){
+        checkpointInterval_    = std::numeric_limits<std::size_t>::max();
+        eventsSinceCheckpoint_ = 0;
+    }
+    
+    runAlgorithm();
+    return 0;
+}
+
+
+// the settings of the engine, with the results & the one checkpoint a run of the processes needs: the last
+// checkpoint before the edits (then the segments & checkpoints before it stay here), or the results when nothing
+// is edited; with neither, the detached run starts from t = 0
+template <typename Time>
+inline BasicSchedulingEngine<Time> BasicSchedulingEngine<Time>::detach(const std::vector<BasicProcess<Time>> &processes,
+                                                                       const std::string &algorithm, const Time &timeQuantum,
+                                                                       const CpuConfig &cpuConfig) const {
+    BasicSchedulingEngine detached;
+    detached.algorithm_      = algorithm_;
+    detached.timeQuantum_    = timeQuantum_;
+    detached.cpuConfig_      = cpuConfig_;
+    detached.switchCosts_    = switchCosts_;
+    detached.mlfqConfig_     = mlfqConfig_;
+    detached.cfsConfig_      = cfsConfig_;
+    detached.ioConfig_       = ioConfig_;
+    detached.shareConfig_    = shareConfig_;
+    detached.realTimeConfig_ = realTimeConfig_;
+    detached.burstTrace_     = burstTrace_;
+    detached.checkpointing_  = checkpointing_;
+    detached.checkpointInterval_ = checkpointInterval_;
+    
+    std::vector<int> editedProcesses;
+    std::ptrdiff_t resume = resumePoint(processes, algorithm, timeQuantum, cpuConfig, editedProcesses);
+    if (resume < 0)  return detached;
+    
+    detached.arrivalOrder_ = arrivalOrder_;
+    detached.state_.processes = state_.processes; // the inputs of the last run, to find the edits again
+    if (resume == static_cast<std::ptrdiff_t>(checkpoints_.size())){
+        detached.state_ = state_;
+        resume = checkpoints_.size() - 1;
+    }
+    detached.checkpoints_.push_back(checkpoints_[resume]);
+    detached.checkpointOffset_ = resume;
+    detached.segmentOffset_    = (editedProcesses.empty()) ? segmentOffset_ + ganttSegments_.size() : checkpoints_[resume].segmentCount;
+    return detached;
+}
+
+
+// the results of a detached run (see detach()), which must be the last run of the detached engine; this engine
+// must not run meanwhile, the results are built on its segments & checkpoints
+template <typename Time>
+inline void BasicSchedulingEngine<Time>::attach(BasicSchedulingEngine &&detached){
+    
+    // a resumed run kept the checkpoints & the segments before its first one, in which the edited processes restart
+    if (detached.reusedResults_){
+        std::vector<int> editedProcesses;
+        for (std::size_t i = 0; i < state_.processes.size(); ++i){
+            if (not sameInputs(state_.processes[i], detached.state_.processes[i]))  editedProcesses.push_back(i);
+        }
+        checkpoints_.resize(detached.checkpointOffset_, BasicSimulationState<Time>());
+        for (auto &state : checkpoints_){ restartEdited(state, editedProcesses, detached.state_.processes); }
+        checkpoints_.insert(checkpoints_.end(), std::make_move_iterator(detached.checkpoints_.begin()),
+                            std::make_move_iterator(detached.checkpoints_.end()));
+        
+        ganttSegments_.resize(detached.segmentOffset_ - segmentOffset_, BasicGanttSegment<Time>(0, 0, 0));
+        ganttSegments_.insert(ganttSegments_.end(), detached.ganttSegments_.begin(), detached.ganttSegments_.end());
+    } else {
+        checkpoints_   = std::move(detached.checkpoints_);
+        ganttSegments_ = std::move(detached.ganttSegments_);
+        segmentOffset_ = checkpointOffset_ = 0;
+    }
+    state_                 = std::move(detached.state_);
+    arrivalOrder_          = std::move(detached.arrivalOrder_);
+    algorithm_             = detached.algorithm_;
+    timeQuantum_           = detached.timeQuantum_;
+    cpuConfig_             = detached.cpuConfig_;
+    checkpointInterval_    = detached.checkpointInterval_;
+    eventsSinceCheckpoint_ = detached.eventsSinceCheckpoint_;
+    cancelled_             = detached.cancelled_;
+    reusedResults_         = detached.reusedResults_;
+    counters_              = detached.counters_;
+    deadlineReport_        = std::move(detached.deadlineReport_);
+}
+
+
+// sort process indices by arrival time, ties are broken by the process id
+// so that the arrived prefix of the order never changes when a later process is edited
+// the order of the previous run is reused as long as it still holds (e.g. the same workload under another
+// policy or quantum), and so is the input order when it is already sorted; both are checked in O(n)
+// otherwise big traces are radix sorted on the arrival times, and only runs of equal arrivals by their ids
+template <typename Time>
+inline void BasicSchedulingEngine<Time>::prepareArrivalOrder(){
+    
+    const std::size_t radixSortThreshold = 4096; // below it std::sort is faster
+    
+    const auto &processes = state_.processes;
+    auto arrivesBefore = [&processes](const int i1, const int i2){
+        if (processes[i1].arrivalTime != processes[i2].arrivalTime)
+            return  processes[i1].arrivalTime < processes[i2].arrivalTime;
+        return  processes[i1].id < processes[i2].id;
+    };
+    auto isSorted = [&](){
+        return  std::is_sorted(arrivalOrder_.begin(), arrivalOrder_.end(), arrivesBefore);
+    };
+    
+    // the previous order is a permutation of the same no. of processes
+    if (arrivalOrder_.size() == processes.size()  and  isSorted())  return;
+    
+    std::size_t n = processes.size();
+    arrivalOrder_.resize(n);
+    for (std::size_t i = 0; i < n; ++i){ arrivalOrder_[i] = i; }
+    if (isSorted())  return;
+    
+    if (n < radixSortThreshold){
+        std::sort(arrivalOrder_.begin(), arrivalOrder_.end(), arrivesBefore);
+        return;
+    }
+    std::vector<std::pair<std::uint64_t, int>> arrivals(n); // (arrival key, index) in index order
+    for (std::size_t i = 0; i < n; ++i){ arrivals[i] = { TimeTraits<Time>::sortKey(processes[i].arrivalTime), static_cast<int>(i) }; }
+    radixSortByKey(arrivals);
+    
+    for (std::size_t first = 0, last; first < n; first = last){
+        for (last = first; last < n  and  arrivals[last].first == arrivals[first].first; ++last){
+            arrivalOrder_[last] = arrivals[last].second;
+        }
+        if (last - first > 1)  std::sort(arrivalOrder_.begin() + first, arrivalOrder_.begin() + last, arrivesBefore);
+    }
+}
+
+
+// save a copy of the simulation state after every checkpointInterval_ events
+// returns false if the run is cancelled, then the policy must stop immediately
+template <typename Time>
+inline bool BasicSchedulingEngine<Time>::checkpoint(){
+    
+    if (cancelToken_  and  cancelToken_->load(std::memory_order_relaxed) != runToken_){
+        cancelled_ = true;
+        return false;
+    }
+    PROFILE_COUNT(counters_.events);
+    if (++eventsSinceCheckpoint_ < checkpointInterval_)  return true;
+    
+    state_.segmentCount = segmentOffset_ + ganttSegments_.size();
+    checkpoints_.push_back(state_);
+    PROFILE_COUNT(counters_.allocations);
+    eventsSinceCheckpoint_ = 0;
+    return true;
+}
+
+
+// add the newly arrived processes in a ready queue
+// as the processes are already sorted thus no need to iterate from first to last
+template <typename Time>
+inline void BasicSchedulingEngine<Time>::admitArrivedProcesses(){
+    
+    int totalProcesses = arrivalOrder_.size();
+    while (state_.arrivedProcessIndex < totalProcesses  and
+            state_.processes[arrivalOrder_[state_.arrivedProcessIndex]].arrivalTime <= state_.cpuCycle){
+        state_.readyQueue.push_back(arrivalOrder_[state_.arrivedProcessIndex]);
+        ++state_.arrivedProcessIndex;
+    }
+    PROFILE_HIGH_WATER(counters_.queueHighWater, state_.readyQueue.size());
+}
+
+
+// every policy reports a finished segment here
+template <typename Time>
+inline void BasicSchedulingEngine<Time>::addSegment(const int &processId, const Time &startTime, const Time &endTime, const int &core,
+                                                    const bool &overhead){
+    
+    if (not overhead)  PROFILE_COUNT(counters_.dispatches);
+    if (keepSegments_){
+        if (ganttSegments_.size() == ganttSegments_.capacity())  PROFILE_COUNT(counters_.allocations);
+        ganttSegments_.emplace_back(processId, startTime, endTime, core, overhead);
+    }
+    if (segmentSink_)   segmentSink_(BasicGanttSegment<Time>(processId, startTime, endTime, core, overhead));
+}
+
+
+// every policy calls it when it puts a process (index) on a cpu, returns the time the cpu spends on the switch
+// a process that continues on the cpu it ran on last, with no other process in between, costs nothing
+// the policy runs the process after the switch, which is never preempted (so the process is warm once it's done)
+template <typename Time>
+inline Time BasicSchedulingEngine<Time>::switchCost(const int &processIndex, const int &core){
     
-    ganttSegments_.clear(); // clears the previous gantt chart result
+    if (not switchCosts_.any())  return 0;
     
-    double cpuCycle = 0; // cpu clock cycle 
-    std::vector<Process*> availableProcesses(processes_.size(), nullptr);
+    auto &lastProcess = state_.lastProcessOnCore;
+    auto &lastCore    = state_.lastCoreOfProcess;
+    if (static_cast<int>(lastProcess.size()) <= core)  lastProcess.resize(core + 1, -1);
+    if (lastCore.empty())  lastCore.assign(state_.processes.size(), -1);
     
-    // make copy of the processes into pointers for operations
-    // so that we can do operations without changing the arrangements of processes
-    for (short int i = 0, n = processes_.size(); i < n; ++i){ availableProcesses[i] = &(processes_[i]); }
+    int previousCore = lastCore[processIndex];
+    if (lastProcess[core] == processIndex  and  previousCore == core)  return 0; // its cache is still warm
+    lastProcess[core] = processIndex;
+    lastCore[processIndex] = core;
     
-    // sort processes by arrival time
-    std::sort(availableProcesses.begin(), availableProcesses.end(), 
-                [](const Process *p1, const Process *p2){ 
-                    return  p1->arrivalTime < p2->arrivalTime; 
-                });
+    double cost = switchCosts_.contextSwitch;
+    if (previousCore >= 0)  cost += switchCosts_.cacheWarmup;
+    if (previousCore >= 0  and  previousCore != core)  cost += switchCosts_.migration;
+    return  TimeTraits<Time>::fromDouble(cost);
+}
+
+
+// the switch starts at the current cpu cycle, and is added to the gantt chart as an overhead segment of the process
+template <typename Time>
+inline Time BasicSchedulingEngine<Time>::chargeSwitch(const int &processIndex, const int &core){
+    
+    Time overhead = switchCost(processIndex, core);
+    if (overhead > 0)  addSegment(state_.processes[processIndex].id, state_.cpuCycle, state_.cpuCycle + overhead, core, true);
+    return overhead;
+}
+
+
+// calls the corosponding algorithm for the current simulation
+template <typename Time>
+inline void BasicSchedulingEngine<Time>::runAlgorithm(){
+    
+    if (cpuConfig_.cores > 1  and  supportsMultiCpu(algorithm_)){
+        runSMP();
+        state_.segmentCount = segmentOffset_ + ganttSegments_.size();
+        return;
+    }
+    if (algorithm_ == "FCFS")    runFCFS();
+    if (algorithm_ == "SJF")     runSJF();
+    if (algorithm_ == "PR")      runPriority();
+    if (algorithm_ == "RR")      runRoundRobin();
+    if (algorithm_ == "SRTF")    runSRTF();
+    if (algorithm_ == "PRP")     runPRP();
+    if (algorithm_ == "IO")      runIO();
+    if (algorithm_ == "MLFQ")    runMLFQ();
+    if (algorithm_ == "CFS")     runCFS();
+    if (isProportionalShare(algorithm_))  runProportionalShare();
+    if (isRealTime(algorithm_))  runRealTime();
+    
+    state_.segmentCount = segmentOffset_ + ganttSegments_.size();
+}
+
+
+// it calculates the FIST-COME-FIRST-SERVE result
+template <typename Time>
+inline void BasicSchedulingEngine<Time>::runFCFS(){
+    
+    Time &cpuCycle = state_.cpuCycle; // cpu clock cycle
+    int totalProcesses = arrivalOrder_.size();
     
-    for (auto &process : availableProcesses){
+    // processes are taken in the order of their arrival
+    while (state_.arrivedProcessIndex < totalProcesses){
+        
+        if (not checkpoint())  return; // cancelled
+        int processIndex = arrivalOrder_[state_.arrivedProcessIndex];
+        BasicProcess<Time> *process = &(state_.processes[processIndex]);
+        ++state_.arrivedProcessIndex;
         
         // wait for process to arrive if no proceeses are in the queue
         if (cpuCycle < process->arrivalTime){ cpuCycle = process->arrivalTime; }
+        cpuCycle += chargeSwitch(processIndex);
         
         // calculate times
         auto process_startTime = cpuCycle;
@@ -38,59 +441,42 @@ inline void ProcessSchedulingCalculator::displayFCFSResults(){
         process->responseTime   = process_startTime       - process->arrivalTime;
         
         // add this process to the Gantt chart
-        ganttSegments_.emplace_back(process->id, process_startTime, 
-                                    process->completionTime, getProcessColor(process->id));
+        addSegment(process->id, process_startTime, process->completionTime);
     }
-    availableProcesses.clear(); // after calculation remove the pointer references
-    
-    updateGanttChart(ganttSegments_);
-    updateStatistics(processes_);
 }
 
 
 // it calculates the SHORTEST-JOB-FIRST result
-inline void ProcessSchedulingCalculator::displaySJFResults(){
-    
-    ganttSegments_.clear(); // clears the previous gantt chart result
+template <typename Time>
+inline void BasicSchedulingEngine<Time>::runSJF(){
     
-    double cpuCycle = 0; // cpu clock cycle
-    short int arrivedProcessIndex = 0, totalProcesses = processes_.size(); 
-    std::vector<Process*> availableProcesses(totalProcesses, nullptr), readyQueue;
-    readyQueue.reserve(totalProcesses);
-    
-    for (short int i = 0; i < totalProcesses; ++i){ availableProcesses[i] = &(processes_[i]); }
-    
-    // sort processes by arrival time
-    std::sort(availableProcesses.begin(), availableProcesses.end(), 
-                [](const Process *p1, const Process *p2){ 
-                    return  p1->arrivalTime < p2->arrivalTime; 
-                });
+    Time &cpuCycle = state_.cpuCycle; // cpu clock cycle
+    int totalProcesses = arrivalOrder_.size();
+    auto &readyQueue = state_.readyQueue;
     
     // when all processes are arrived and ready queue become empty,
     // it means all the processes are executed successfully
-    while (arrivedProcessIndex < totalProcesses  ||  not readyQueue.empty()){
+    while (state_.arrivedProcessIndex < totalProcesses  ||  not readyQueue.empty()){
+        
+        if (not checkpoint())  return; // cancelled
+        admitArrivedProcesses();
         
-        // add the newly arrived processes in a ready queue
-        // as the processes are already sorted thus no need to iterate from first to last
-        while (arrivedProcessIndex < totalProcesses  and  
-                availableProcesses[arrivedProcessIndex]->arrivalTime <= cpuCycle){
-            readyQueue.push_back(availableProcesses[arrivedProcessIndex]);
-            ++arrivedProcessIndex;
-        }
         // if no new process arrived in this cpu clock cycle (means gap exists between this process and cpu cycle)
         // thus assign this process arrival time to the current cpu cycle
         if (readyQueue.empty()){
-            if (arrivedProcessIndex < totalProcesses){
-                cpuCycle = availableProcesses[arrivedProcessIndex]->arrivalTime;
+            if (state_.arrivedProcessIndex < totalProcesses){
+                cpuCycle = state_.processes[arrivalOrder_[state_.arrivedProcessIndex]].arrivalTime;
             }
             continue;
         }
         // finding the process with smallest burst time from arrived processes
         auto shortestProcessIterator = std::min_element(readyQueue.begin(), readyQueue.end(),
-                                                        [](const Process *p1, const Process *p2){ 
-                                                            return  p1->burstTime < p2->burstTime; 
+                                                        [this](const int i1, const int i2){
+                                                            return  state_.processes[i1].burstTime <
+                                                                    state_.processes[i2].burstTime;
                                                         });
-        Process *shortestProcess = *shortestProcessIterator;
+        BasicProcess<Time> *shortestProcess = &(state_.processes[*shortestProcessIterator]);
+        cpuCycle += chargeSwitch(*shortestProcessIterator);
         
         // execute the smallest burst time arrived process
         auto shortestProcess_startTime = cpuCycle;
@@ -101,64 +487,47 @@ inline void ProcessSchedulingCalculator::displaySJFResults(){
         shortestProcess->responseTime   = shortestProcess_startTime       - shortestProcess->arrivalTime;
         
         // add this process to the Gantt chart
-        ganttSegments_.emplace_back(shortestProcess->id, shortestProcess_startTime, 
-                                    shortestProcess->completionTime, getProcessColor(shortestProcess->id));
+        addSegment(shortestProcess->id, shortestProcess_startTime, shortestProcess->completionTime);
         
         // remove the executed processes reference from the ready queue
         readyQueue.erase(shortestProcessIterator);
     }
-    availableProcesses.clear(); // after calculation remove the references
-    
-    updateGanttChart(ganttSegments_);
-    updateStatistics(processes_);
 }
 
 
 // it calculates the PRIORITY (non-premetive-version) result
-inline void ProcessSchedulingCalculator::displayPriorityResults(){
-    
-    ganttSegments_.clear(); // clears the previous gantt chart result
+template <typename Time>
+inline void BasicSchedulingEngine<Time>::runPriority(){
     
-    double cpuCycle = 0; // cpu clock cycle
-    short int arrivedProcessIndex = 0, totalProcesses = processes_.size(); 
-    std::vector<Process*> availableProcesses(totalProcesses, nullptr), readyQueue;
-    readyQueue.reserve(totalProcesses);
-    
-    for (short int i = 0; i < totalProcesses; ++i){ availableProcesses[i] = &(processes_[i]); }
-    
-    // sort processes by arrival time
-    std::sort(availableProcesses.begin(), availableProcesses.end(), 
-                [](const Process *p1, const Process *p2){ 
-                    return  p1->arrivalTime < p2->arrivalTime; 
-                });
+    Time &cpuCycle = state_.cpuCycle; // cpu clock cycle
+    int totalProcesses = arrivalOrder_.size();
+    auto &readyQueue = state_.readyQueue;
     
     // when all processes are arrived and ready queue become empty,
     // it means all the processes are executed successfully
-    while (arrivedProcessIndex < totalProcesses  ||  not readyQueue.empty()){
+    while (state_.arrivedProcessIndex < totalProcesses  ||  not readyQueue.empty()){
+        
+        if (not checkpoint())  return; // cancelled
+        admitArrivedProcesses();
         
-        // add the newly arrived processes in a ready queue
-        // as the processes are already sorted thus no need to iterate from first to last
-        while (arrivedProcessIndex < totalProcesses  and  
-                availableProcesses[arrivedProcessIndex]->arrivalTime <= cpuCycle){
-            readyQueue.push_back(availableProcesses[arrivedProcessIndex]);
-            ++arrivedProcessIndex;
-        }
         // if no new process arrived in this cpu clock cycle (means gap exists between this process and cpu cycle)
         // thus assign this process arrival time to the current cpu cycle
         if (readyQueue.empty()){
-            if (arrivedProcessIndex < totalProcesses){
-                cpuCycle = availableProcesses[arrivedProcessIndex]->arrivalTime;
+            if (state_.arrivedProcessIndex < totalProcesses){
+                cpuCycle = state_.processes[arrivalOrder_[state_.arrivedProcessIndex]].arrivalTime;
             }
             continue;
         }
-        // finding the process with smallest burst time from arrived processes
+        // finding the process with highest priority from arrived processes
         auto highestPriorityProcessIterator = std::max_element(readyQueue.begin(), readyQueue.end(),
-                                                                [](const Process *p1, const Process *p2){ 
-                                                                    return  p1->priority < p2->priority; 
+                                                                [this](const int i1, const int i2){
+                                                                    return  state_.processes[i1].priority <
+                                                                            state_.processes[i2].priority;
                                                                 });
-        Process *highestPriorityProcess = *highestPriorityProcessIterator;
+        BasicProcess<Time> *highestPriorityProcess = &(state_.processes[*highestPriorityProcessIterator]);
+        cpuCycle += chargeSwitch(*highestPriorityProcessIterator);
         
-        // execute the smallest burst time arrived process
+        // execute the highest priority arrived process
         auto highestPriorityProcess_startTime = cpuCycle;
         cpuCycle += highestPriorityProcess->burstTime;
         highestPriorityProcess->completionTime = cpuCycle;
@@ -167,52 +536,38 @@ inline void ProcessSchedulingCalculator::displayPriorityResults(){
         highestPriorityProcess->responseTime   = highestPriorityProcess_startTime       - highestPriorityProcess->arrivalTime;
         
         // add this process to the Gantt chart
-        ganttSegments_.emplace_back(highestPriorityProcess->id, highestPriorityProcess_startTime, 
-                                    highestPriorityProcess->completionTime, getProcessColor(highestPriorityProcess->id));
+        addSegment(highestPriorityProcess->id, highestPriorityProcess_startTime, highestPriorityProcess->completionTime);
         
         // remove the executed processes reference from the ready queue
         readyQueue.erase(highestPriorityProcessIterator);
     }
-    availableProcesses.clear(); // after calculation remove the references
-    
-    updateGanttChart(ganttSegments_);
-    updateStatistics(processes_);
 }
 
 
 // it calculates the ROUND-ROBIN result
-inline void ProcessSchedulingCalculator::displayRoundRobinResults(){
-    
-    ganttSegments_.clear(); // clears the previous gantt chart result
-    
-    double cpuCycle = 0; // cpu clock cycle 
-    short int arrivedProcessIndex = 0, totalProcesses = processes_.size(); 
-    std::vector<Process*> availableProcesses(totalProcesses, nullptr);
-    std::list<Process*> readyQueue;
+template <typename Time>
+inline void BasicSchedulingEngine<Time>::runRoundRobin(){
     
-    for (short int i = 0; i < totalProcesses; ++i){ availableProcesses[i] = &(processes_[i]); }
+    Time &cpuCycle = state_.cpuCycle; // cpu clock cycle
+    int totalProcesses = arrivalOrder_.size();
+    auto &readyQueue = state_.readyQueue;
     
-    std::sort(availableProcesses.begin(), availableProcesses.end(), 
-                [](const Process *p1, const Process *p2){ 
-                    return  p1->arrivalTime < p2->arrivalTime; 
-                });
-    
-    while (arrivedProcessIndex < totalProcesses  ||  not readyQueue.empty()){
+    while (state_.arrivedProcessIndex < totalProcesses  ||  not readyQueue.empty()){
+        
+        if (not checkpoint())  return; // cancelled
+        admitArrivedProcesses();
         
-        while (arrivedProcessIndex < totalProcesses  and  
-                availableProcesses[arrivedProcessIndex]->arrivalTime <= cpuCycle){
-            readyQueue.push_back(availableProcesses[arrivedProcessIndex]);
-            ++arrivedProcessIndex;
-        }
         if (readyQueue.empty()){
-            if (arrivedProcessIndex < totalProcesses){
-                cpuCycle = availableProcesses[arrivedProcessIndex]->arrivalTime;
+            if (state_.arrivedProcessIndex < totalProcesses){
+                cpuCycle = state_.processes[arrivalOrder_[state_.arrivedProcessIndex]].arrivalTime;
             }
             continue;
         }
         // choose the first process and remove from the ready queue for execution
-        Process *currentProcess = readyQueue.front();
+        int currentProcessIndex = readyQueue.front();
+        BasicProcess<Time> *currentProcess = &(state_.processes[currentProcessIndex]);
         readyQueue.pop_front();
+        cpuCycle += chargeSwitch(currentProcessIndex); // arrivals during the switch queue up with those of the slice
         
         if (not currentProcess->started){ // set response time if first time running
             currentProcess->responseTime = cpuCycle - currentProcess->arrivalTime;
@@ -226,20 +581,19 @@ inline void ProcessSchedulingCalculator::displayRoundRobinResults(){
         else  cpuCycle += timeQuantum_;
         
         // add this process to the Gantt chart
-        ganttSegments_.emplace_back(currentProcess->id, currentProcess_startTime, 
-                                    cpuCycle, getProcessColor(currentProcess->id));
+        addSegment(currentProcess->id, currentProcess_startTime, cpuCycle);
         
         // add newly arrived processes during execution
-        while (arrivedProcessIndex < totalProcesses  and  
-                availableProcesses[arrivedProcessIndex]->arrivalTime <= cpuCycle){
-            readyQueue.push_back(availableProcesses[arrivedProcessIndex]);
-            ++arrivedProcessIndex;
-        }
+        admitArrivedProcesses();
         
         // decrese the remainig time of the current process
-        currentProcess->remainingTime -= timeQuantum_; 
+        currentProcess->remainingTime -= std::min(currentProcess->remainingTime, timeQuantum_); // time it really ran
         // if the process is not over, put again in the queue, otherwise calculate it
-        if (currentProcess->remainingTime > 0){ readyQueue.push_back(currentProcess); }
+        if (currentProcess->remainingTime > 0){
+            readyQueue.push_back(currentProcessIndex);
+            PROFILE_COUNT(counters_.preemptions);
+            PROFILE_HIGH_WATER(counters_.queueHighWater, readyQueue.size());
+        }
         else { // process completed
             currentProcess->completionTime = cpuCycle;
             currentProcess->turnaroundTime = currentProcess->completionTime - currentProcess->arrivalTime;
@@ -247,138 +601,131 @@ inline void ProcessSchedulingCalculator::displayRoundRobinResults(){
             // response time is already set
         }
     }
-    availableProcesses.clear(); // after calculation remove the references
-    
-    updateGanttChart(ganttSegments_);
-    updateStatistics(processes_);
 }
 
 
 // it calculates the SHORTEST-REMAINING-TIME-FIRST result
-inline void ProcessSchedulingCalculator::displaySRTFResults(){
+// event driven: the ready queue is a min-heap on the remaining time, and the running process
+// is only preempted when a process with a strictly shorter remaining time arrives,
+// otherwise its gantt segment simply continues through the arrival
+template <typename Time>
+inline void BasicSchedulingEngine<Time>::runSRTF(){
     
-    ganttSegments_.clear(); // clears the previous gantt chart result
+    Time &cpuCycle = state_.cpuCycle; // cpu clock cycle
+    int totalProcesses = arrivalOrder_.size();
+    auto &readyQueue = state_.readyQueue;
+    auto &processes  = state_.processes;
     
-    double executionTime = 0, cpuCycle = 0; // cpu clock cycle 
-    short int arrivedProcessIndex = 0, totalProcesses = processes_.size(); 
-    std::vector<Process*> availableProcesses(totalProcesses, nullptr), readyQueue;
-    
-    for (short int i = 0; i < totalProcesses; ++i){ availableProcesses[i] = &(processes_[i]); }
-    
-    std::sort(availableProcesses.begin(), availableProcesses.end(), 
-                [](const Process *p1, const Process *p2){ 
-                    return  p1->arrivalTime < p2->arrivalTime; 
-                });
+    // heap order, the process with the shortest remaining time (then the earliest arrival) is on the top
+    auto longerRemainingTime = [&processes](const int i1, const int i2){
+        const BasicProcess<Time> &p1 = processes[i1], &p2 = processes[i2];
+        if (p1.remainingTime != p2.remainingTime)  return  p1.remainingTime > p2.remainingTime;
+        if (p1.arrivalTime   != p2.arrivalTime)    return  p1.arrivalTime   > p2.arrivalTime;
+        return  p1.id > p2.id;
+    };
+    // add the processes arrived upto the current cpu cycle into the ready heap
+    auto admitArrivals = [&](){
+        while (state_.arrivedProcessIndex < totalProcesses  and
+                processes[arrivalOrder_[state_.arrivedProcessIndex]].arrivalTime <= cpuCycle){
+            readyQueue.push_back(arrivalOrder_[state_.arrivedProcessIndex]);
+            std::push_heap(readyQueue.begin(), readyQueue.end(), longerRemainingTime);
+            ++state_.arrivedProcessIndex;
+        }
+        PROFILE_HIGH_WATER(counters_.queueHighWater, readyQueue.size());
+    };
+    // close the gantt segment of the running process at the current cpu cycle
+    auto closeSegment = [&](){
+        addSegment(processes[state_.runningProcess].id, state_.segmentStartTime, cpuCycle);
+    };
     
-    while (arrivedProcessIndex < totalProcesses  ||  not readyQueue.empty()){
+    while (state_.arrivedProcessIndex < totalProcesses  ||  not readyQueue.empty()  ||  state_.runningProcess >= 0){
         
-        while (arrivedProcessIndex < totalProcesses  and  
-                availableProcesses[arrivedProcessIndex]->arrivalTime <= cpuCycle){
-            readyQueue.push_back(availableProcesses[arrivedProcessIndex]);
-            ++arrivedProcessIndex;
-        }
-        if (readyQueue.empty()){
-            if (arrivedProcessIndex < totalProcesses){
-                cpuCycle = availableProcesses[arrivedProcessIndex]->arrivalTime;
-            }
-            continue;
-        }
-        // finding the process with shortest remaining time from arrived processes
-        auto shortestProcessIterator = std::min_element(readyQueue.begin(), readyQueue.end(),
-                                                        [](const Process *p1, const Process *p2){ 
-                                                            return  p1->remainingTime < p2->remainingTime; 
-                                                        });
-        Process *currentShortestProcess = *shortestProcessIterator;
-        readyQueue.erase(shortestProcessIterator);
+        if (not checkpoint())  return; // cancelled
+        admitArrivals();
         
-        if (not currentShortestProcess->started){ // set response time if first time running
-            currentShortestProcess->responseTime = cpuCycle - currentShortestProcess->arrivalTime;
-            currentShortestProcess->started = true;
-        }
-        // if next process remaining time is less than the current process remaining then,
-        // execution time is set to the difference between next process arrival and current cpu clock
-        // so that this(current process) executes upto next process arrival
-        if (arrivedProcessIndex < totalProcesses  and  arrivedProcessIndex > 0){
-            executionTime = availableProcesses[arrivedProcessIndex]->arrivalTime - cpuCycle;
-            // if the next process arrival is more than this process remainig 
-            if (executionTime > currentShortestProcess->remainingTime)
-                executionTime = currentShortestProcess->remainingTime;
+        if (state_.runningProcess < 0){ // cpu is free, dispatch the shortest ready process
+            if (readyQueue.empty()){ // jump to the next arrival
+                cpuCycle = processes[arrivalOrder_[state_.arrivedProcessIndex]].arrivalTime;
+                continue;
+            }
+            std::pop_heap(readyQueue.begin(), readyQueue.end(), longerRemainingTime);
+            state_.runningProcess   = readyQueue.back();
+            readyQueue.pop_back();
+            cpuCycle += chargeSwitch(state_.runningProcess);
+            state_.segmentStartTime = cpuCycle;
+            
+            BasicProcess<Time> &dispatchedProcess = processes[state_.runningProcess];
+            if (not dispatchedProcess.started){ // set response time if first time running
+                dispatchedProcess.responseTime = cpuCycle - dispatchedProcess.arrivalTime;
+                dispatchedProcess.started = true;
+            }
         }
-        // when all pocesses arrived there is no chance of premption
-        else  executionTime = currentShortestProcess->remainingTime;
-        
-        cpuCycle += executionTime;
+        BasicProcess<Time> &runningProcess = processes[state_.runningProcess];
         
-        // add this process to the Gantt chart
-        ganttSegments_.emplace_back(currentShortestProcess->id, cpuCycle - executionTime, 
-                                    cpuCycle, getProcessColor(currentShortestProcess->id));
-        
-        // add newly arrived processes during execution
-        while (arrivedProcessIndex < totalProcesses  and  
-                availableProcesses[arrivedProcessIndex]->arrivalTime <= cpuCycle){
-            readyQueue.push_back(availableProcesses[arrivedProcessIndex]);
-            ++arrivedProcessIndex;
-        }
+        // next event: either the running process completes, or the next process arrives
+        // (a process that arrived during the switch to the running one is taken into account right after it)
+        Time completionTime = cpuCycle + runningProcess.remainingTime;
+        Time nextArrivalTime = (state_.arrivedProcessIndex < totalProcesses) ?
+                                 std::max(cpuCycle, processes[arrivalOrder_[state_.arrivedProcessIndex]].arrivalTime) : completionTime;
         
-        // decrese the remainig time of the current process
-        currentShortestProcess->remainingTime -= executionTime; 
-        // if the process is not over, put again in the queue, otherwise calculate it
-        if (currentShortestProcess->remainingTime > 0){ readyQueue.push_back(currentShortestProcess); }
-        else { // process completed
-            currentShortestProcess->completionTime = cpuCycle;
-            currentShortestProcess->turnaroundTime = currentShortestProcess->completionTime - currentShortestProcess->arrivalTime;
-            currentShortestProcess->waitingTime    = currentShortestProcess->turnaroundTime - currentShortestProcess->burstTime;
+        if (completionTime <= nextArrivalTime){ // process completed
+            cpuCycle = completionTime;
+            runningProcess.remainingTime  = 0;
+            runningProcess.completionTime = cpuCycle;
+            runningProcess.turnaroundTime = runningProcess.completionTime - runningProcess.arrivalTime;
+            runningProcess.waitingTime    = runningProcess.turnaroundTime - runningProcess.burstTime;
             // response time is already set
+            
+            closeSegment();
+            state_.runningProcess = -1;
+            continue;
         }
+        // execute upto the next arrival, and preempt only if a shorter process arrived
+        runningProcess.remainingTime -= nextArrivalTime - cpuCycle;
+        cpuCycle = nextArrivalTime;
+        admitArrivals();
         
-        /* ---------------- for debugging purpose -------------------
-        std::cout <<std::endl<< currentShortestProcess->id <<" : "<< cpuCycle <<std::endl;
-        for (Process *p : readyQueue)  std::cout <<" "<< p->id <<"|"<< p->remainingTime;
-        */
+        if (not readyQueue.empty()  and  processes[readyQueue.front()].remainingTime < runningProcess.remainingTime){
+            if (cpuCycle > state_.segmentStartTime)  closeSegment();
+            readyQueue.push_back(state_.runningProcess);
+            std::push_heap(readyQueue.begin(), readyQueue.end(), longerRemainingTime);
+            state_.runningProcess = -1;
+            PROFILE_COUNT(counters_.preemptions);
+            PROFILE_HIGH_WATER(counters_.queueHighWater, readyQueue.size());
+        }
     }
-    availableProcesses.clear(); // after calculation remove the references
-    
-    updateGanttChart(ganttSegments_);
-    updateStatistics(processes_);
 }
 
 
 // it calculates the PRIORITY (premetive-version) result
-inline void ProcessSchedulingCalculator::displayPRPResults(){
-    
-    ganttSegments_.clear(); // clears the previous gantt chart result
+template <typename Time>
+inline void BasicSchedulingEngine<Time>::runPRP(){
     
-    double executionTime = 0, cpuCycle = 0; // cpu clock cycle 
-    short int arrivedProcessIndex = 0, totalProcesses = processes_.size(); 
-    std::vector<Process*> availableProcesses(totalProcesses, nullptr), readyQueue;
+    Time executionTime = 0, &cpuCycle = state_.cpuCycle; // cpu clock cycle
+    int totalProcesses = arrivalOrder_.size();
+    auto &readyQueue = state_.readyQueue;
     
-    for (short int i = 0; i < totalProcesses; ++i){ availableProcesses[i] = &(processes_[i]); }
-    
-    std::sort(availableProcesses.begin(), availableProcesses.end(), 
-                [](const Process *p1, const Process *p2){ 
-                    return  p1->arrivalTime < p2->arrivalTime; 
-                });
-    
-    while (arrivedProcessIndex < totalProcesses  ||  not readyQueue.empty()){
+    while (state_.arrivedProcessIndex < totalProcesses  ||  not readyQueue.empty()){
+        
+        if (not checkpoint())  return; // cancelled
+        admitArrivedProcesses();
         
-        while (arrivedProcessIndex < totalProcesses  and  
-                availableProcesses[arrivedProcessIndex]->arrivalTime <= cpuCycle){
-            readyQueue.push_back(availableProcesses[arrivedProcessIndex]);
-            ++arrivedProcessIndex;
-        }
         if (readyQueue.empty()){
-            if (arrivedProcessIndex < totalProcesses){
-                cpuCycle = availableProcesses[arrivedProcessIndex]->arrivalTime;
+            if (state_.arrivedProcessIndex < totalProcesses){
+                cpuCycle = state_.processes[arrivalOrder_[state_.arrivedProcessIndex]].arrivalTime;
             }
             continue;
         }
         // finding the highest priority process from arrived processes
         auto highestPriorityProcessIterator = std::max_element(readyQueue.begin(), readyQueue.end(),
-                                                                [](const Process *p1, const Process *p2){ 
-                                                                    return  p1->priority < p2->priority; 
+                                                                [this](const int i1, const int i2){
+                                                                    return  state_.processes[i1].priority <
+                                                                            state_.processes[i2].priority;
                                                                 });
-        Process *highestPriorityProcess = *highestPriorityProcessIterator;
+        int highestPriorityProcessIndex = *highestPriorityProcessIterator;
+        BasicProcess<Time> *highestPriorityProcess = &(state_.processes[highestPriorityProcessIndex]);
         readyQueue.erase(highestPriorityProcessIterator);
+        cpuCycle += chargeSwitch(highestPriorityProcessIndex);
         
         if (not highestPriorityProcess->started){ // set response time if first time running
             highestPriorityProcess->responseTime = cpuCycle - highestPriorityProcess->arrivalTime;
@@ -387,190 +734,1010 @@ inline void ProcessSchedulingCalculator::displayPRPResults(){
         // if next process remaining time is less than the current process remaining then,
         // execution time is set to the difference between next process arrival and current cpu clock
         // so that this(current process) executes upto next process arrival
-        if (arrivedProcessIndex < totalProcesses  and  arrivedProcessIndex > 0){
-            executionTime = availableProcesses[arrivedProcessIndex]->arrivalTime - cpuCycle;
-            // if the next process arrival is more than this process remainig 
+        if (state_.arrivedProcessIndex < totalProcesses  and  state_.arrivedProcessIndex > 0){
+            executionTime = state_.processes[arrivalOrder_[state_.arrivedProcessIndex]].arrivalTime - cpuCycle;
+            // if the next process arrival is more than this process remainig
             if (executionTime > highestPriorityProcess->remainingTime)
                 executionTime = highestPriorityProcess->remainingTime;
         }
         // when all pocesses arrived there is no chance of premption
         else  executionTime = highestPriorityProcess->remainingTime;
         
+        // the next process arrived during the switch to this one, so it is chosen again right away
+        if (executionTime < 0)  executionTime = 0;
         cpuCycle += executionTime;
         
         // add this process to the Gantt chart
-        ganttSegments_.emplace_back(highestPriorityProcess->id, cpuCycle - executionTime, 
-                                    cpuCycle, getProcessColor(highestPriorityProcess->id));
-        
-        while (arrivedProcessIndex < totalProcesses  and  
-                availableProcesses[arrivedProcessIndex]->arrivalTime <= cpuCycle){
-            readyQueue.push_back(availableProcesses[arrivedProcessIndex]);
-            ++arrivedProcessIndex;
+        if (executionTime > 0  or  executionTime == highestPriorityProcess->remainingTime){
+            addSegment(highestPriorityProcess->id, cpuCycle - executionTime, cpuCycle);
         }
         
-        highestPriorityProcess->remainingTime -= executionTime; 
-        if (highestPriorityProcess->remainingTime > 0){ readyQueue.push_back(highestPriorityProcess); }
+        admitArrivedProcesses();
+        
+        highestPriorityProcess->remainingTime -= executionTime;
+        if (highestPriorityProcess->remainingTime > 0){
+            readyQueue.push_back(highestPriorityProcessIndex);
+            PROFILE_COUNT(counters_.preemptions);
+            PROFILE_HIGH_WATER(counters_.queueHighWater, readyQueue.size());
+        }
         else { // process completed
             highestPriorityProcess->completionTime = cpuCycle;
             highestPriorityProcess->turnaroundTime = highestPriorityProcess->completionTime - highestPriorityProcess->arrivalTime;
             highestPriorityProcess->waitingTime    = highestPriorityProcess->turnaroundTime - highestPriorityProcess->burstTime;
         }
-        
-        /* ---------------- for debugging purpose -------------------
-        std::cout <<std::endl<< highestPriorityProcess->id <<" : "<< cpuCycle <<std::endl;
-        for (Process *p : readyQueue)  std::cout <<" "<< p->id <<"|"<< p->remainingTime;
-        */
     }
-    availableProcesses.clear();
-    
-    updateGanttChart(ganttSegments_);
-    updateStatistics(processes_);
 }
 
 
 // it calculates the I/O SCHEDULING result
-inline void ProcessSchedulingCalculator::displayIOResults(){
-    
-    ganttSegments_.clear(); // clears the previous gantt chart result
-    
-    short int arrivedProcesses = 0, totalProcesses = processes_.size(); 
-    std::vector<double> processIoStartTime(totalProcesses, 0.0);
-    double executionTime = 0.0, cpuCycle = 0.0; // cpu clock cycle 
-    std::vector<bool> processArrived(totalProcesses, false), processIoComplete(totalProcesses, false);
-    std::vector<Process*> availableProcesses(totalProcesses, nullptr);
-    std::list<Process*> readyQueue, ioQueue;
-    
-    for (short int i = 0; i < totalProcesses; ++i){ availableProcesses[i] = &(processes_[i]); }
-    
-    auto processArrivalCheck = [&](){
-        if (arrivedProcesses < totalProcesses){ // put arrived processes in queue
-            for (Process *process : availableProcesses){
-                if (not processArrived[process->id - 1]  and  process->arrivalTime <= cpuCycle){
-                    readyQueue.push_back(process);
-                    processArrived[process->id - 1] = true;
-                    ++arrivedProcesses;
-                }
+// every process is a sequence of cpu & i/o phases, the cpu runs the highest priority ready process (preemptive,
+// equal priorities by the order they became ready) while the i/o phases run on their devices in parallel;
+// a busy device queues the requests in its own discipline, and with unlimited devices every i/o starts at once
+// the phases are read from one contiguous array, the ready processes & every device queue are heaps and the
+// i/o completions are a min-heap of events, so every event costs O(log n) however many phases a process has
+template <typename Time>
+inline void BasicSchedulingEngine<Time>::runIO(){
+    
+    Time &cpuCycle = state_.cpuCycle; // cpu clock cycle
+    auto &processes = state_.processes;
+    int totalProcesses = arrivalOrder_.size();
+    int devices = std::max(0, ioConfig_.devices);
+    const Time never = TimeTraits<Time>::never();
+    
+    // phases of every process, zero length phases are dropped
+    BurstTrace trace;
+    bool fromTrace = (burstTrace_.processCount() == processes.size());
+    for (int i = 0; i < totalProcesses; ++i){
+        std::vector<Burst> phases;
+        if (fromTrace){
+            for (std::size_t b = burstTrace_.offsets[i]; b < burstTrace_.offsets[i + 1]; ++b){
+                const Burst &burst = burstTrace_.bursts[b];
+                int device = (burst.device < 0  or  devices == 0) ? burst.device : burst.device % devices;
+                if (TimeTraits<Time>::fromDouble(burst.duration) > 0)  phases.emplace_back(burst.duration, device);
             }
         }
+        else {
+            if (processes[i].burstTime  > 0)  phases.emplace_back(static_cast<double>(processes[i].burstTime));
+            if (processes[i].ioTime     > 0)  phases.emplace_back(static_cast<double>(processes[i].ioTime), (devices) ? i % devices : 0);
+            if (processes[i].burstTime2 > 0)  phases.emplace_back(static_cast<double>(processes[i].burstTime2));
+        }
+        trace.addProcess(phases);
+        
+        if (fromTrace){ // the statistics take the totals: all cpu phases as the burst time, all i/o phases as the i/o time
+            processes[i].burstTime = processes[i].burstTime2 = processes[i].ioTime = 0;
+            for (const auto &phase : phases){
+                (phase.device < 0 ? processes[i].burstTime : processes[i].ioTime) += TimeTraits<Time>::fromDouble(phase.duration);
+            }
+        }
+    }
+    
+    struct ReadyEntry { int priority; unsigned long long order; int process; };   // higher priority runs first
+    struct IoEntry    { double key; unsigned long long order; int process; };     // smaller key gets the device first
+    struct IoEvent    { Time time; unsigned long long order; int process; int device; };
+    
+    auto laterReady = [](const ReadyEntry &e1, const ReadyEntry &e2){
+        return  (e1.priority != e2.priority) ? e1.priority < e2.priority : e1.order > e2.order;
+    };
+    auto laterIo = [](const IoEntry &e1, const IoEntry &e2){
+        return  (e1.key != e2.key) ? e1.key > e2.key : e1.order > e2.order;
     };
-    auto processIoCheck = [&](){
-        for (auto it = ioQueue.begin();  it != ioQueue.end();  ){
-            Process *ioProcess = *it;
-            if (cpuCycle  >=  processIoStartTime[ioProcess->id - 1] + ioProcess->ioTime){
-                readyQueue.push_back(ioProcess);
-                processIoComplete[ioProcess->id - 1] = true;
-                it = ioQueue.erase(it); // point to the next valid iterator
+    auto laterEvent = [](const IoEvent &e1, const IoEvent &e2){
+        return  (e1.time != e2.time) ? e1.time > e2.time : e1.order > e2.order;
+    };
+    
+    std::vector<ReadyEntry> readyHeap;
+    std::vector<IoEvent> ioEvents;                          // i/o phases in progress
+    std::vector<std::vector<IoEntry>> deviceQueues(devices); // requests waiting for each busy device
+    std::vector<bool> deviceBusy(devices, false);
+    std::vector<std::size_t> phase(totalProcesses);         // current phase of each process (position in the trace)
+    std::vector<Time> phaseRemaining(totalProcesses);       // remaining time of the current phase
+    unsigned long long readyCount = 0, ioCount = 0;        // orders of the ready entries & of the i/o starts
+    
+    ReadyEntry running{0, 0, -1};     // process on the cpu, with its ready entry
+    Time segmentStartTime = 0;        // start of its gantt segment
+    Time accountedTime = 0;           // its phase remaining time is upto this time (the end of the switch to it, if later)
+    
+    auto startIo = [&](const int processIndex, const int device){
+        ioEvents.push_back(IoEvent{cpuCycle + phaseRemaining[processIndex], ioCount++, processIndex, device});
+        std::push_heap(ioEvents.begin(), ioEvents.end(), laterEvent);
+        if (device >= 0  and  device < devices)  deviceBusy[device] = true;
+    };
+    // moves the process to its next phase (or completes it), the cpu phases go to the ready heap
+    // and the i/o phases to their device, a process that is on the cpu stays there for a next cpu phase
+    auto nextPhase = [&](const int processIndex, const bool &onCpu){
+        std::size_t end = trace.offsets[processIndex + 1];
+        if (phase[processIndex] == end){ // process completed
+            BasicProcess<Time> &process = processes[processIndex];
+            process.completionTime = cpuCycle;
+            process.turnaroundTime = process.completionTime - process.arrivalTime;
+            process.waitingTime    = process.turnaroundTime - (process.burstTime + process.burstTime2);
+            return false;
+        }
+        const Burst &burst = trace.bursts[phase[processIndex]];
+        phaseRemaining[processIndex] = TimeTraits<Time>::fromDouble(burst.duration);
+        
+        if (burst.device < 0){
+            if (onCpu)  return true;
+            readyHeap.push_back(ReadyEntry{processes[processIndex].priority, readyCount++, processIndex});
+            std::push_heap(readyHeap.begin(), readyHeap.end(), laterReady);
+            PROFILE_HIGH_WATER(counters_.queueHighWater, readyHeap.size());
+        }
+        else if (devices == 0  or  not deviceBusy[burst.device]){ startIo(processIndex, burst.device); }
+        else {
+            double key = 0; // FCFS
+            if (burst.device < static_cast<int>(ioConfig_.disciplines.size())){
+                if (ioConfig_.disciplines[burst.device] == IoConfig::SHORTEST_FIRST)  key = burst.duration;
+                if (ioConfig_.disciplines[burst.device] == IoConfig::PRIORITY)  key = -processes[processIndex].priority;
             }
-            else  ++it; // iterate to the next element
+            deviceQueues[burst.device].push_back(IoEntry{key, ioCount++, processIndex});
+            std::push_heap(deviceQueues[burst.device].begin(), deviceQueues[burst.device].end(), laterIo);
+        }
+        return false;
+    };
+    auto stopRunning = [&](){
+        if (cpuCycle > segmentStartTime){ // add this run to the Gantt chart
+            addSegment(processes[running.process].id, segmentStartTime, cpuCycle);
         }
+        running.process = -1;
     };
     
-    while (arrivedProcesses < totalProcesses  ||  not readyQueue.empty()  ||  not ioQueue.empty()){
+    for (int i = 0; i < totalProcesses; ++i){ phase[i] = trace.offsets[i]; }
+    
+    while (true){
+        
+        if (not checkpoint())  return; // cancelled
         
-        processArrivalCheck();
-        processIoCheck();
+        Time nextArrivalTime = (state_.arrivedProcessIndex < totalProcesses) ?
+                               processes[arrivalOrder_[state_.arrivedProcessIndex]].arrivalTime : never;
+        Time nextIoTime  = (ioEvents.empty()) ? never : ioEvents.front().time;
+        Time nextCpuTime = (running.process >= 0) ? accountedTime + phaseRemaining[running.process] : never;
+        Time switchEnd   = (running.process >= 0  and  accountedTime > cpuCycle) ? accountedTime : never;
+        Time nextEventTime = std::min({nextArrivalTime, nextIoTime, nextCpuTime, switchEnd});
+        if (nextEventTime == never)  break; // all done
         
-        if (readyQueue.empty()){ // when no process are in queue 
-            // Jump to next event time instead of fixed step
-            double nextEventTime = 1e18; // Large value
+        cpuCycle = nextEventTime;
+        
+        // 1. cpu phase of the running process ends
+        if (running.process >= 0){
+            if (cpuCycle == nextCpuTime){
+                int processIndex = running.process;
+                ++phase[processIndex];
+                if (not nextPhase(processIndex, true))  stopRunning();
+                else  accountedTime = cpuCycle; // next cpu phase right away
+            }
+            else if (cpuCycle > accountedTime){
+                phaseRemaining[running.process] -= cpuCycle - accountedTime;
+                accountedTime = cpuCycle;
+            }
+        }
+        // 2. newly arrived processes start their first phase
+        while (state_.arrivedProcessIndex < totalProcesses  and
+                processes[arrivalOrder_[state_.arrivedProcessIndex]].arrivalTime <= cpuCycle){
+            int processIndex = arrivalOrder_[state_.arrivedProcessIndex++];
+            nextPhase(processIndex, false);
+        }
+        // 3. completed i/o phases, their device takes the next waiting request
+        while (not ioEvents.empty()  and  ioEvents.front().time <= cpuCycle){
+            IoEvent event = ioEvents.front();
+            std::pop_heap(ioEvents.begin(), ioEvents.end(), laterEvent);
+            ioEvents.pop_back();
             
-            // Check next arrival
-            if (arrivedProcesses < totalProcesses) {
-                for (Process *p : availableProcesses) {
-                    if (!processArrived[p->id - 1]) {
-                        nextEventTime = std::min(nextEventTime, p->arrivalTime);
-                    }
+            if (event.device >= 0  and  event.device < devices){
+                deviceBusy[event.device] = false;
+                auto &queue = deviceQueues[event.device];
+                if (not queue.empty()){
+                    std::pop_heap(queue.begin(), queue.end(), laterIo);
+                    int waitingProcess = queue.back().process;
+                    queue.pop_back();
+                    startIo(waitingProcess, event.device);
                 }
             }
-            // Check next IO completion
-            for (Process *p : ioQueue) {
-                double ioEndTime = processIoStartTime[p->id - 1] + p->ioTime;
-                nextEventTime = std::min(nextEventTime, ioEndTime);
+            ++phase[event.process];
+            nextPhase(event.process, false);
+        }
+        // 4. a higher priority ready process preempts the running one (once switched to), an idle cpu takes the highest one
+        if (running.process >= 0  and  accountedTime <= cpuCycle  and  not readyHeap.empty()  and  laterReady(running, readyHeap.front())){
+            readyHeap.push_back(running); // keeps its position among equal priorities
+            std::push_heap(readyHeap.begin(), readyHeap.end(), laterReady);
+            stopRunning();
+            PROFILE_COUNT(counters_.preemptions);
+            PROFILE_HIGH_WATER(counters_.queueHighWater, readyHeap.size());
+        }
+        if (running.process < 0  and  not readyHeap.empty()){
+            std::pop_heap(readyHeap.begin(), readyHeap.end(), laterReady);
+            running = readyHeap.back();
+            readyHeap.pop_back();
+            segmentStartTime = accountedTime = cpuCycle + chargeSwitch(running.process); // the i/o goes on meanwhile
+            
+            BasicProcess<Time> &process = processes[running.process];
+            if (not process.started){ // set response time if first time running
+                process.responseTime = segmentStartTime - process.arrivalTime;
+                process.started = true;
+            }
+        }
+    }
+}
+
+
+// it calculates the MULTILEVEL-FEEDBACK-QUEUE result
+// new processes start at level 0 (highest), a process that uses up the allotment of its level moves one level down,
+// a process at a lower level is preempted by a new arrival, and every boost interval all processes go back to level 0
+// each level is a ring queue and the non-empty levels are bits of a 64-bit mask, so the next process is found in O(1)
+template <typename Time>
+inline void BasicSchedulingEngine<Time>::runMLFQ(){
+    
+    Time &cpuCycle = state_.cpuCycle; // cpu clock cycle
+    auto &processes = state_.processes;
+    int totalProcesses = arrivalOrder_.size();
+    int levels = std::min(64, std::max(1, mlfqConfig_.levels));
+    const Time never = TimeTraits<Time>::never();
+    
+    // allotment of each level
+    std::vector<Time> quanta(levels);
+    for (int l = 0; l < levels; ++l){
+        double quantum = (mlfqConfig_.quanta.empty()) ? static_cast<double>(timeQuantum_) * std::ldexp(1.0, l) :
+                         mlfqConfig_.quanta[std::min<std::size_t>(l, mlfqConfig_.quanta.size() - 1)];
+        quanta[l] = (quantum > 0) ? TimeTraits<Time>::positive(quantum) : never; // 0: no allotment limit at this level
+    }
+    Time boostInterval = (mlfqConfig_.boostInterval > 0) ? TimeTraits<Time>::positive(mlfqConfig_.boostInterval) : never;
+    std::vector<RingQueue> queues(levels);
+    std::uint64_t occupiedLevels = 0;                   // bit l is set when level l has a waiting process
+    std::vector<int> level(processes.size(), 0);        // current level of each process
+    std::vector<Time> allotmentUsed(processes.size(), 0);     // cpu time used at the current level
+    std::vector<unsigned> boostEpoch(processes.size(), 0);    // boosts seen by each process (older: allotment is reset)
+    unsigned boosts = 0;
+    
+    auto enqueue = [&](const int processIndex){
+        queues[level[processIndex]].push(processIndex);
+        occupiedLevels |= std::uint64_t(1) << level[processIndex];
+        PROFILE_HIGH_WATER(counters_.queueHighWater, queues[level[processIndex]].size());
+    };
+    // newly arrived processes start at the highest level
+    auto admitArrivals = [&](){
+        while (state_.arrivedProcessIndex < totalProcesses  and
+                processes[arrivalOrder_[state_.arrivedProcessIndex]].arrivalTime <= cpuCycle){
+            enqueue(arrivalOrder_[state_.arrivedProcessIndex++]);
+        }
+    };
+    auto dequeueHighest = [&](){
+        int l = __builtin_ctzll(occupiedLevels); // lowest set bit = highest non-empty level
+        int processIndex = queues[l].pop();
+        if (queues[l].empty())  occupiedLevels &= ~(std::uint64_t(1) << l);
+        return  processIndex;
+    };
+    
+    int running = -1;                 // process on the cpu
+    Time segmentStartTime = 0;        // start of its gantt segment
+    Time nextBoost = boostInterval;
+    
+    while (true){
+        
+        if (not checkpoint())  return; // cancelled
+        
+        admitArrivals();
+        Time nextArrivalTime = (state_.arrivedProcessIndex < totalProcesses) ?
+                               processes[arrivalOrder_[state_.arrivedProcessIndex]].arrivalTime : never;
+        
+        // a higher level process is waiting, so the running one is preempted (it keeps its level & allotment)
+        if (running >= 0  and  occupiedLevels  and  __builtin_ctzll(occupiedLevels) < level[running]){
+            if (cpuCycle > segmentStartTime)  addSegment(processes[running].id, segmentStartTime, cpuCycle);
+            enqueue(running);
+            running = -1;
+            PROFILE_COUNT(counters_.preemptions);
+        }
+        if (running < 0){
+            if (not occupiedLevels){
+                if (nextArrivalTime == never)  break; // all done
+                cpuCycle = nextArrivalTime; // cpu is idle until then
+                while (nextBoost <= cpuCycle){ nextBoost += boostInterval; } // nothing to boost
+                continue;
             }
-            // set the next event time accordingly based on the next event type
-            if (nextEventTime > cpuCycle && nextEventTime < 1e18) { cpuCycle = nextEventTime; }
-            else if (nextEventTime == 1e18) { break; } // Should not happen if loop condition is true
+            running = dequeueHighest();
+            Time overhead = chargeSwitch(running);
+            cpuCycle += overhead;
+            segmentStartTime = cpuCycle;
+            if (boostEpoch[running] != boosts){ allotmentUsed[running] = 0;  boostEpoch[running] = boosts; }
             
-            continue; 
+            BasicProcess<Time> &process = processes[running];
+            if (not process.started){ // set response time if first time running
+                process.responseTime = cpuCycle - process.arrivalTime;
+                process.started = true;
+            }
+            if (overhead > 0)  continue; // the arrivals during the switch may preempt it right away
         }
         
-        // finding the highest priority process from arrived processes
-        auto highestPriorityProcessIterator = std::max_element(readyQueue.begin(), readyQueue.end(),
-                                                                [](const Process *p1, const Process *p2){ 
-                                                                    return  p1->priority < p2->priority; 
-                                                                });
-        Process *highestPriorityProcess = *highestPriorityProcessIterator;
+        // run until the process completes, uses up its allotment, a new arrival or a boost
+        BasicProcess<Time> &process = processes[running];
+        Time allotmentLeft = (quanta[level[running]] == never) ? never : quanta[level[running]] - allotmentUsed[running];
+        Time sliceEnd = cpuCycle + std::min(process.remainingTime, allotmentLeft);
+        Time nextEvent = std::min({sliceEnd, nextArrivalTime, std::max(cpuCycle, nextBoost)}); // a boost may be due since the switch
         
-        if (not highestPriorityProcess->started){ // set response time if first time running
-            highestPriorityProcess->responseTime = cpuCycle - highestPriorityProcess->arrivalTime;
-            highestPriorityProcess->started = true;
+        bool completes = (nextEvent == sliceEnd  and  process.remainingTime <= allotmentLeft);
+        bool demoted   = (nextEvent == sliceEnd  and  not completes);
+        process.remainingTime   = (completes) ? 0 : process.remainingTime - (nextEvent - cpuCycle);
+        allotmentUsed[running] += nextEvent - cpuCycle;
+        cpuCycle = nextEvent;
+        admitArrivals(); // arrivals at this very moment queue up before a demoted process (as in RR)
+        
+        if (completes){ // process completed
+            addSegment(process.id, segmentStartTime, cpuCycle);
+            process.completionTime = cpuCycle;
+            process.turnaroundTime = process.completionTime - process.arrivalTime;
+            process.waitingTime    = process.turnaroundTime - process.burstTime;
+            running = -1;
+        }
+        else if (demoted){ // allotment used up, goes to the end of the next lower level
+            addSegment(process.id, segmentStartTime, cpuCycle);
+            level[running] = std::min(level[running] + 1, levels - 1);
+            allotmentUsed[running] = 0;
+            enqueue(running);
+            running = -1;
+            PROFILE_COUNT(counters_.preemptions);
         }
         
-        // -------------------------- Calculate execution time based on next events ---------------------------
-        // Event 1: next burst end
-        // Event 2: next arrival
-        // Event 3: next IO completion
+        // priority boost, every process is moved to level 0 (in the order of the levels)
+        if (cpuCycle >= nextBoost){
+            for (int l = 1; l < levels; ++l){
+                while (not queues[l].empty()){
+                    int processIndex = queues[l].pop();
+                    level[processIndex] = 0;
+                    queues[0].push(processIndex);
+                }
+            }
+            if (occupiedLevels)  occupiedLevels = 1;
+            ++boosts; // the allotments of the waiting processes are reset when they are dispatched
+            if (running >= 0){ level[running] = 0;  allotmentUsed[running] = 0;  boostEpoch[running] = boosts; }
+            while (nextBoost <= cpuCycle){ nextBoost += boostInterval; }
+        }
+    }
+}
 
-        // Check against next burst end & set the execution time to it 
-        double timeToBurstEnd = (not processIoComplete[highestPriorityProcess->id - 1]) ? 
-                                highestPriorityProcess->remainingTime : highestPriorityProcess->remainingTime2;
-        executionTime = timeToBurstEnd;
 
-        // Check against next arrival & set if the arrival is less than the current execution
-        if (arrivedProcesses < totalProcesses) {
-            for (Process *p : availableProcesses) {
-                if (not processArrived[p->id - 1]) {
-                    double timeToArrival = p->arrivalTime - cpuCycle;
-                    if (timeToArrival > 0) executionTime = std::min(executionTime, timeToArrival);
-                }
+// it calculates the COMPLETELY-FAIR-SCHEDULER (CFS) result, modelled on the linux scheduler
+// every process gets a weight from its priority (priority 1 - 100 is spread over nice 19 - -20), and its vruntime
+// grows by (run time * 1024 / weight); the process with the smallest vruntime runs next, for a slice of the
+// target latency in proportion to its weight; a new arrival starts at the minimum vruntime, and preempts the
+// running process when it is more than the minimum granularity behind
+// the runnable processes are an ordered tree on (vruntime, arrival rank), its begin() is the cached leftmost
+template <typename Time>
+inline void BasicSchedulingEngine<Time>::runCFS(){
+    
+    // weight of each nice level (-20 - 19) in the linux kernel, every level is ~1.25x of the next one
+    static const double niceToWeight[40] = {
+        88761, 71755, 56483, 46273, 36291, 29154, 23254, 18705, 14949, 11916,
+        9548,  7620,  6100,  4904,  3906,  3121,  2501,  1991,  1586,  1277,
+        1024,  820,   655,   526,   423,   335,   272,   215,   172,   137,
+        110,   87,    70,    56,    45,    36,    29,    23,    18,    15,
+    };
+    Time &cpuCycle = state_.cpuCycle; // cpu clock cycle
+    auto &processes = state_.processes;
+    int totalProcesses = arrivalOrder_.size();
+    const Time never = TimeTraits<Time>::never();
+    double targetLatency  = std::max(cfsConfig_.targetLatency, 1e-9);
+    double minGranularity = std::max(cfsConfig_.minGranularity, 1e-9);
+    
+    std::vector<double> weight(processes.size()), vruntime(processes.size(), 0.0);
+    std::vector<int> arrivalRank(processes.size());
+    for (int i = 0; i < totalProcesses; ++i){ arrivalRank[arrivalOrder_[i]] = i; }
+    for (std::size_t i = 0; i < processes.size(); ++i){
+        int priority = std::min(100, std::max(1, processes[i].priority));
+        int nice = 19 - (priority - 1) * 39 / 99; // priority 1 -> nice 19, priority 100 -> nice -20
+        weight[i] = niceToWeight[nice + 20];
+    }
+    
+    std::set<std::pair<double, int>> timeline;   // (vruntime, arrival rank) of the waiting processes
+    double totalWeight = 0;                      // of the waiting & the running processes
+    double minVruntime = 0;                      // never decreases, new arrivals start from it
+    
+    int running = -1;                 // process on the cpu
+    Time segmentStartTime = 0;        // start of its gantt segment
+    Time accountedTime = 0;           // its vruntime & remaining time are upto this time
+    Time sliceEnd = 0;                // end of its current slice
+    
+    auto updateMinVruntime = [&](){
+        double smallest = std::numeric_limits<double>::infinity();
+        if (running >= 0)  smallest = vruntime[running];
+        if (not timeline.empty())  smallest = std::min(smallest, timeline.begin()->first);
+        if (smallest != std::numeric_limits<double>::infinity())  minVruntime = std::max(minVruntime, smallest);
+    };
+    // run the process on the cpu upto now
+    auto account = [&](){
+        Time ran = cpuCycle - accountedTime;
+        vruntime[running] += static_cast<double>(ran) * 1024 / weight[running];
+        processes[running].remainingTime -= ran;
+        accountedTime = cpuCycle;
+    };
+    auto stop = [&](){
+        if (cpuCycle > segmentStartTime)  addSegment(processes[running].id, segmentStartTime, cpuCycle);
+        timeline.insert({vruntime[running], arrivalRank[running]});
+        running = -1;
+        PROFILE_COUNT(counters_.preemptions);
+        PROFILE_HIGH_WATER(counters_.queueHighWater, timeline.size());
+    };
+    
+    while (true){
+        
+        if (not checkpoint())  return; // cancelled
+        
+        // newly arrived processes are placed at the minimum vruntime
+        bool arrived = false;
+        while (state_.arrivedProcessIndex < totalProcesses  and
+                processes[arrivalOrder_[state_.arrivedProcessIndex]].arrivalTime <= cpuCycle){
+            int processIndex = arrivalOrder_[state_.arrivedProcessIndex++];
+            vruntime[processIndex] = minVruntime;
+            timeline.insert({vruntime[processIndex], arrivalRank[processIndex]});
+            totalWeight += weight[processIndex];
+            arrived = true;
+        }
+        PROFILE_HIGH_WATER(counters_.queueHighWater, timeline.size());
+        
+        // wakeup preemption, the leftmost waiting process is far enough behind the running one
+        if (arrived  and  running >= 0  and  not timeline.empty()){
+            int leftmost = arrivalOrder_[timeline.begin()->second];
+            if (vruntime[running] - vruntime[leftmost] > minGranularity * 1024 / weight[leftmost])  stop();
+        }
+        if (running < 0){
+            if (timeline.empty()){
+                if (state_.arrivedProcessIndex >= totalProcesses)  break; // all done
+                cpuCycle = processes[arrivalOrder_[state_.arrivedProcessIndex]].arrivalTime; // cpu is idle until then
+                continue;
+            }
+            running = arrivalOrder_[timeline.begin()->second];
+            timeline.erase(timeline.begin());
+            Time overhead = chargeSwitch(running);
+            cpuCycle += overhead;
+            segmentStartTime = accountedTime = cpuCycle;
+            
+            BasicProcess<Time> &process = processes[running];
+            if (not process.started){ // set response time if first time running
+                process.responseTime = cpuCycle - process.arrivalTime;
+                process.started = true;
+            }
+            // the period is stretched when the runnable processes don't fit with the minimum granularity
+            double period = std::max(targetLatency, (timeline.size() + 1) * minGranularity);
+            sliceEnd = cpuCycle + TimeTraits<Time>::positive(std::max(minGranularity, period * weight[running] / totalWeight));
+            if (overhead > 0)  continue; // the arrivals during the switch may preempt it right away
+        }
+        
+        // run until the process completes, its slice ends or a new arrival
+        BasicProcess<Time> &process = processes[running];
+        Time completion = accountedTime + process.remainingTime;
+        Time nextArrivalTime = (state_.arrivedProcessIndex < totalProcesses) ?
+                               processes[arrivalOrder_[state_.arrivedProcessIndex]].arrivalTime : never;
+        cpuCycle = std::min({completion, sliceEnd, nextArrivalTime});
+        
+        if (cpuCycle == completion){ // process completed
+            addSegment(process.id, segmentStartTime, cpuCycle);
+            account();
+            process.remainingTime  = 0;
+            process.completionTime = cpuCycle;
+            process.turnaroundTime = process.completionTime - process.arrivalTime;
+            process.waitingTime    = process.turnaroundTime - process.burstTime;
+            totalWeight -= weight[running];
+            running = -1;
+        }
+        else if (cpuCycle == sliceEnd){ // slice used up, back into the timeline
+            account();
+            stop();
+        }
+        else { // an arrival, the running process is accounted upto now (it may be preempted by the arrival)
+            account();
+        }
+        updateMinVruntime();
+    }
+}
+
+
+// it calculates the STRIDE or the LOTTERY (proportional-share) result
+// every process holds its priority (1 - 100) as tickets, and gets the cpu for a time quantum at a time,
+// in proportion to its tickets among the ready processes; arrivals during a quantum join before it ends (as in RR)
+// STRIDE runs the smallest pass (ties: earlier arrival), and the pass grows by the run time / (quantum * tickets);
+// an arrival starts at the pass of the last dispatch, so it can't make up for the time before it arrived
+// LOTTERY draws a ticket of the ready processes at random (seeded), from a fenwick tree of their tickets
+// both pick the next process in O(log n)
+template <typename Time>
+inline void BasicSchedulingEngine<Time>::runProportionalShare(){
+    
+    Time &cpuCycle = state_.cpuCycle; // cpu clock cycle
+    auto &processes = state_.processes;
+    int totalProcesses = arrivalOrder_.size();
+    bool lottery = (algorithm_ == "LOTTERY");
+    
+    std::vector<std::uint64_t> tickets(totalProcesses); // by arrival rank
+    for (int rank = 0; rank < totalProcesses; ++rank){
+        tickets[rank] = std::min(100, std::max(1, processes[arrivalOrder_[rank]].priority));
+    }
+    
+    // STRIDE: (pass, arrival rank) of the ready processes
+    std::vector<double> pass(totalProcesses, 0.0);
+    std::priority_queue<std::pair<double, int>, std::vector<std::pair<double, int>>, std::greater<std::pair<double, int>>> passes;
+    double dispatchPass = 0; // pass of the last dispatch, the smallest one at that time
+    
+    // LOTTERY: fenwick[i] is the sum of the tickets of the ready ranks (i - lowbit(i), i]
+    std::vector<std::uint64_t> fenwick(totalProcesses + 1, 0);
+    std::uint64_t readyTickets = 0;
+    std::mt19937_64 random(shareConfig_.lotterySeed);
+    int topStep = 1;
+    while (topStep * 2 <= totalProcesses){ topStep *= 2; }
+    
+    auto updateTickets = [&](const int rank, const std::uint64_t &amount, const bool &add){
+        readyTickets = (add) ? readyTickets + amount : readyTickets - amount;
+        for (int i = rank + 1; i <= totalProcesses; i += i & -i){ fenwick[i] = (add) ? fenwick[i] + amount : fenwick[i] - amount; }
+    };
+    auto drawTicket = [&](){ // rank of the winner, the one whose tickets cover a random ticket number
+        std::uint64_t ticket = random() % readyTickets;
+        int position = 0;
+        for (int step = topStep; step > 0; step /= 2){
+            if (position + step <= totalProcesses  and  fenwick[position + step] <= ticket){
+                position += step;
+                ticket -= fenwick[position];
+            }
+        }
+        return position;
+    };
+    
+    std::size_t waiting = 0; // ready processes besides the running one
+    auto enqueue = [&](const int rank){
+        if (lottery)  updateTickets(rank, tickets[rank], true);
+        else  passes.push({pass[rank], rank});
+        ++waiting;
+        PROFILE_HIGH_WATER(counters_.queueHighWater, waiting);
+    };
+    auto dequeue = [&](){
+        int rank;
+        if (lottery){ rank = drawTicket();  updateTickets(rank, tickets[rank], false); }
+        else { rank = passes.top().second;  passes.pop();  dispatchPass = std::max(dispatchPass, pass[rank]); }
+        --waiting;
+        return rank;
+    };
+    auto admitArrivals = [&](){
+        while (state_.arrivedProcessIndex < totalProcesses  and
+                processes[arrivalOrder_[state_.arrivedProcessIndex]].arrivalTime <= cpuCycle){
+            int rank = state_.arrivedProcessIndex++;
+            pass[rank] = dispatchPass;
+            enqueue(rank);
+        }
+    };
+    
+    int running = -1;                 // arrival rank of the process on the cpu
+    Time segmentStartTime = 0;        // start of its gantt segment (continued while it wins again)
+    
+    // the winner runs after the switch to it, arrivals during the switch join before its quantum ends
+    auto dispatch = [&](const int rank){
+        running = rank;
+        cpuCycle += chargeSwitch(arrivalOrder_[running]);
+        segmentStartTime = cpuCycle;
+        
+        BasicProcess<Time> &process = processes[arrivalOrder_[running]];
+        if (not process.started){ // set response time if first time running
+            process.responseTime = cpuCycle - process.arrivalTime;
+            process.started = true;
+        }
+    };
+    
+    while (true){
+        
+        if (not checkpoint())  return; // cancelled
+        admitArrivals();
+        
+        if (running < 0){
+            if (waiting == 0){
+                if (state_.arrivedProcessIndex >= totalProcesses)  break; // all done
+                cpuCycle = processes[arrivalOrder_[state_.arrivedProcessIndex]].arrivalTime; // cpu is idle until then
+                continue;
             }
+            dispatch(dequeue());
         }
         
-        // Check against next IO completion & set if the IO completion is less than the current execution
-        for (Process *p : ioQueue) {
-            double timeToIoEnd = (processIoStartTime[p->id - 1] + p->ioTime) - cpuCycle;
-            if (timeToIoEnd > 0) executionTime = std::min(executionTime, timeToIoEnd);
+        // run for a quantum, or less to completion
+        BasicProcess<Time> &process = processes[arrivalOrder_[running]];
+        Time ran = std::min(process.remainingTime, timeQuantum_);
+        cpuCycle += ran;
+        process.remainingTime -= ran;
+        pass[running] += static_cast<double>(ran) / timeQuantum_ / tickets[running];
+        admitArrivals();
+        
+        if (process.remainingTime <= 0){ // process completed
+            addSegment(process.id, segmentStartTime, cpuCycle);
+            process.remainingTime  = 0;
+            process.completionTime = cpuCycle;
+            process.turnaroundTime = process.completionTime - process.arrivalTime;
+            process.waitingTime    = process.turnaroundTime - process.burstTime;
+            running = -1;
+            continue;
+        }
+        if (waiting == 0)  continue; // alone, keeps the cpu
+        
+        // quantum used up, the next one is picked among all the ready processes (may be the same one again)
+        int previous = running;
+        enqueue(running);
+        int next = dequeue();
+        if (next != previous){
+            addSegment(process.id, segmentStartTime, cpuCycle);
+            dispatch(next);
+            PROFILE_COUNT(counters_.preemptions);
         }
+    }
+}
+
+
+// it calculates the EARLIEST-DEADLINE-FIRST (EDF) or the RATE-MONOTONIC (RMS) result, both preemptive
+// a process with a period is a periodic task: released at its arrival and then every period before the horizon,
+// each release (job) runs burstTime and is due deadline (or one period) after it; other processes are released once
+// EDF runs the ready job with the earliest absolute deadline, RMS the job of the shortest period (a job released
+// once: of the shortest relative deadline, none is last); ties go to the earlier release, then to the arrival order
+// the ready jobs & the next release of every task are two heaps, so a run is O(jobs * log(processes))
+// the results of a process are the worst of its jobs, the misses & the lateness are in deadlineReport()
+template <typename Time>
+inline void BasicSchedulingEngine<Time>::runRealTime(){
+    
+    struct Job {
+        Time  key;          // EDF: absolute deadline, RMS: period of the task
+        Time  release;
+        Time  deadline;     // absolute, never if none
+        Time  remaining;
+        int   rank;         // arrival rank of the task
+        bool  started;
+    };
+    auto after = [](const Job &j1, const Job &j2){ // j1 runs after j2
+        if (j1.key != j2.key)  return  j1.key > j2.key;
+        if (j1.release != j2.release)  return  j1.release > j2.release;
+        return  j1.rank > j2.rank;
+    };
+    Time &cpuCycle = state_.cpuCycle; // cpu clock cycle
+    auto &processes = state_.processes;
+    int totalProcesses = arrivalOrder_.size();
+    const Time never = TimeTraits<Time>::never();
+    const double tolerance = (std::is_integral<Time>::value) ? 0 : 1e-9; // rounding of the summed double times
+    bool edf = (algorithm_ == "EDF");
+    
+    // default horizon: one hyperperiod after the last first release, capped (see RealTimeConfig)
+    Time horizon = TimeTraits<Time>::fromDouble(realTimeConfig_.releaseHorizon(processes));
+    
+    DeadlineReport &report = deadlineReport_;
+    report.processMisses.assign(processes.size(), 0);
+    for (auto &process : processes){ process.turnaroundTime = process.waitingTime = process.responseTime = 0; }
+    
+    // next release of every task, as (time, arrival rank); the arrival order is already a valid heap
+    std::vector<std::pair<Time, int>> firstReleases(totalProcesses);
+    for (int rank = 0; rank < totalProcesses; ++rank){ firstReleases[rank] = { processes[arrivalOrder_[rank]].arrivalTime, rank }; }
+    std::priority_queue<std::pair<Time, int>, std::vector<std::pair<Time, int>>, std::greater<std::pair<Time, int>>>
+        releases(std::greater<std::pair<Time, int>>(), std::move(firstReleases));
+    std::priority_queue<Job, std::vector<Job>, decltype(after)> ready(after);
+    
+    Job running = Job();              // job on the cpu
+    bool busy = false;                // there is one
+    Time segmentStartTime = 0;        // start of its gantt segment
+    
+    while (true){
         
-        cpuCycle += executionTime; // increase the cpu cycle
+        if (not checkpoint())  return; // cancelled
         
-        // add this process to the Gantt chart
-        ganttSegments_.emplace_back(highestPriorityProcess->id, cpuCycle - executionTime, 
-                                    cpuCycle, getProcessColor(highestPriorityProcess->id));
-        
-        // execute the process
-        if (not processIoComplete[highestPriorityProcess->id - 1]) // when first burst time finish
-            highestPriorityProcess->remainingTime -= executionTime; 
-        else highestPriorityProcess->remainingTime2 -= executionTime;
-        
-        // Check for first burst completion using epsilon for float precision
-        bool firstBurstDone = (not processIoComplete[highestPriorityProcess->id - 1] && highestPriorityProcess->remainingTime <= 1e-9);
-
-        if (firstBurstDone){ 
-            if (highestPriorityProcess->ioTime > 0){ // if the process have io time to perform
-                processIoStartTime[highestPriorityProcess->id - 1] = cpuCycle;
-                readyQueue.erase(highestPriorityProcessIterator);
-                ioQueue.push_back(highestPriorityProcess);
+        // release the jobs that are due, and schedule the next release of their task
+        while (not releases.empty()  and  releases.top().first <= cpuCycle){
+            Time release = releases.top().first;
+            int rank = releases.top().second;
+            releases.pop();
+            
+            const BasicProcess<Time> &task = processes[arrivalOrder_[rank]];
+            Time relativeDeadline = (task.deadline > 0) ? task.deadline : (task.period > 0) ? task.period : never;
+            Time deadline = (relativeDeadline == never) ? never : release + relativeDeadline;
+            Time key = (edf) ? deadline : (task.period > 0) ? task.period : relativeDeadline;
+            ready.push(Job{ key, release, deadline, task.burstTime, rank, false });
+            ++report.jobs;
+            
+            if (task.period > 0  and  release + task.period < horizon)  releases.push({ release + task.period, rank });
+        }
+        PROFILE_HIGH_WATER(counters_.queueHighWater, ready.size());
+        
+        // a released job comes first, the running one waits
+        if (busy  and  not ready.empty()  and  after(running, ready.top())){
+            if (cpuCycle > segmentStartTime)  addSegment(processes[arrivalOrder_[running.rank]].id, segmentStartTime, cpuCycle);
+            ready.push(running);
+            busy = false;
+            PROFILE_COUNT(counters_.preemptions);
+        }
+        if (not busy){
+            if (ready.empty()){
+                if (releases.empty())  break; // all done
+                cpuCycle = releases.top().first; // cpu is idle until then
+                continue;
+            }
+            running = ready.top();
+            ready.pop();
+            busy = true;
+            Time overhead = chargeSwitch(arrivalOrder_[running.rank]);
+            cpuCycle += overhead;
+            segmentStartTime = cpuCycle;
+            
+            BasicProcess<Time> &process = processes[arrivalOrder_[running.rank]];
+            if (not running.started){ // response time of the job, the process keeps the worst one
+                process.responseTime = std::max(process.responseTime, cpuCycle - running.release);
+                process.started = running.started = true;
             }
-            else processIoComplete[highestPriorityProcess->id - 1] = true; // if no io time, then consider io complete
+            if (overhead > 0)  continue; // the releases during the switch may preempt it right away
         }
         
-        // Check for second burst completion using epsilon for float precision
-        bool secondBurstDone = (processIoComplete[highestPriorityProcess->id - 1] && highestPriorityProcess->remainingTime2 <= 1e-9);
+        // run until the job completes or the next release
+        Time completion = cpuCycle + running.remaining;
+        Time nextRelease = (releases.empty()) ? never : releases.top().first;
+        if (nextRelease < completion){
+            running.remaining -= nextRelease - cpuCycle;
+            cpuCycle = nextRelease;
+            continue;
+        }
+        cpuCycle = completion;
+        busy = false;
         
-        if (secondBurstDone){ // process completed
-            highestPriorityProcess->completionTime = cpuCycle;
-            highestPriorityProcess->turnaroundTime = highestPriorityProcess->completionTime - highestPriorityProcess->arrivalTime;
-            highestPriorityProcess->waitingTime    = highestPriorityProcess->turnaroundTime - 
-                                                    (highestPriorityProcess->burstTime + highestPriorityProcess->burstTime2);
-            readyQueue.erase(highestPriorityProcessIterator);
+        int processIndex = arrivalOrder_[running.rank];
+        BasicProcess<Time> &process = processes[processIndex];
+        addSegment(process.id, segmentStartTime, cpuCycle);
+        process.completionTime = cpuCycle;
+        process.turnaroundTime = std::max(process.turnaroundTime, cpuCycle - running.release);
+        process.waitingTime    = process.turnaroundTime - process.burstTime;
+        
+        if (running.deadline != never){
+            double lateness = static_cast<double>(cpuCycle - running.deadline);
+            report.maxLateness = std::max(report.maxLateness, lateness);
+            report.tardiness.add(std::max(0.0, lateness));
+            if (lateness > tolerance){ ++report.deadlineMisses;  ++report.processMisses[processIndex]; }
         }
     }
-    availableProcesses.clear();
+}
+
+
+// it calculates the MULTI-CPU (SMP) result of FCFS, SJF, PR, RR, SRTF & PRP
+// event driven: the slice ends of the cpus are kept in a min-heap (stale entries are skipped by version),
+// every run queue is a heap on the policy's dispatch key, and the idle cpus, the queue loads, the queues with
+// waiting work & the preemption victims are kept in ordered sets, so every event costs O(log n) for any no. of cpus
+template <typename Time>
+inline void BasicSchedulingEngine<Time>::runSMP(){
+    
+    Time &cpuCycle = state_.cpuCycle; // shared clock of all cpus
+    auto &processes = state_.processes;
+    int totalProcesses = arrivalOrder_.size(), cores = cpuConfig_.cores;
+    int queueCount = (cpuConfig_.perCoreQueues) ? cores : 1;
     
-    updateGanttChart(ganttSegments_);
-    updateStatistics(processes_);
+    bool roundRobin = (algorithm_ == "RR");
+    bool shortestJob = (algorithm_ == "SJF"), shortestRemaining = (algorithm_ == "SRTF");
+    bool byPriority = (algorithm_ == "PR"  or  algorithm_ == "PRP");
+    bool preemptive = (algorithm_ == "SRTF"  or  algorithm_ == "PRP");
+    const double tolerance = (std::is_integral<Time>::value) ? 0 : 1e-9; // rounding of the summed double times
+    
+    struct ReadyEntry { double key; unsigned long long order; int process; };   // smaller key runs first
+    struct CoreEvent  { Time time; int core; unsigned version; bool switchEnd; }; // slice end (or switch end) of a cpu
+    struct Cpu        { int process; Time switchStart, segmentStart, slice, sliceEnd; bool completes; unsigned version; };
+    
+    auto laterEntry = [](const ReadyEntry &e1, const ReadyEntry &e2){
+        return  (e1.key != e2.key) ? e1.key > e2.key : e1.order > e2.order;
+    };
+    auto laterEvent = [](const CoreEvent &e1, const CoreEvent &e2){
+        return  (e1.time != e2.time) ? e1.time > e2.time : e1.core > e2.core;
+    };
+    
+    std::vector<std::vector<ReadyEntry>> readyQueues(queueCount);
+    std::vector<CoreEvent> coreEvents;
+    std::vector<Cpu> cpus(cores, Cpu{-1, 0, 0, 0, 0, false, 0});
+    std::set<int> idleCores;                             // idle cpus, the lowest one is used first
+    std::set<std::pair<int, int>> queueLoads;            // (queued + running, queue) of the per-cpu queues
+    std::set<std::pair<int, int>> waitingLoads;          // the same, only of the queues with waiting work (stealing)
+    std::set<std::pair<double, int>> runningKeys;        // (preemption key, cpu) of the busy cpus past their switch (shared queue)
+    std::vector<int> queueLoad(queueCount, 0), touchedQueues;   // touchedQueues: queues that got work in this event
+    std::vector<std::pair<int, int>> unfinishedSlices;          // (cpu, process) of the round-robin slices ending now
+    std::vector<int> arrivalRank(totalProcesses);               // position of each process in the arrival order
+    unsigned long long enqueueCount = 0;
+    
+    for (int i = 0; i < totalProcesses; ++i){ arrivalRank[arrivalOrder_[i]] = i; }
+    
+    for (int c = 0; c < cores; ++c){ idleCores.insert(c); }
+    if (cpuConfig_.perCoreQueues){ for (int q = 0; q < queueCount; ++q){ queueLoads.insert({0, q}); } }
+    
+    // dispatch key of a ready process, FCFS & RR only use the enqueue order
+    auto dispatchKey = [&](const BasicProcess<Time> &process){
+        if (shortestJob)        return  static_cast<double>(process.burstTime);
+        if (shortestRemaining)  return  static_cast<double>(process.remainingTime);
+        if (byPriority)         return  -static_cast<double>(process.priority);
+        return  0.0;
+    };
+    // key of a running process, comparable with the dispatch key of a ready one (bigger is preempted first)
+    // all running processes go down at the same rate, so for SRTF the projected completion time is used
+    auto runningKey = [&](const int core){
+        if (shortestRemaining)  return  static_cast<double>(cpus[core].sliceEnd);
+        return  -static_cast<double>(processes[cpus[core].process].priority);
+    };
+    auto readyKey = [&](const ReadyEntry &entry){
+        return  (shortestRemaining) ? static_cast<double>(cpuCycle) + entry.key : entry.key;
+    };
+    auto changeLoad = [&](const int queue, const int change){
+        if (not cpuConfig_.perCoreQueues)  return;
+        queueLoads.erase({queueLoad[queue], queue});
+        if (cpuConfig_.workStealing)  waitingLoads.erase({queueLoad[queue], queue});
+        queueLoad[queue] += change;
+        queueLoads.insert({queueLoad[queue], queue});
+        if (cpuConfig_.workStealing  and  not readyQueues[queue].empty())  waitingLoads.insert({queueLoad[queue], queue});
+    };
+    // equal keys run in arrival order, only round-robin goes by the enqueue order
+    auto pushReady = [&](const int queue, const int processIndex){
+        unsigned long long order = (roundRobin) ? enqueueCount++ : arrivalRank[processIndex];
+        readyQueues[queue].push_back(ReadyEntry{dispatchKey(processes[processIndex]), order, processIndex});
+        std::push_heap(readyQueues[queue].begin(), readyQueues[queue].end(), laterEntry);
+        changeLoad(queue, +1);
+        PROFILE_HIGH_WATER(counters_.queueHighWater, readyQueues[queue].size());
+    };
+    auto popReady = [&](const int queue){
+        std::pop_heap(readyQueues[queue].begin(), readyQueues[queue].end(), laterEntry);
+        int processIndex = readyQueues[queue].back().process;
+        readyQueues[queue].pop_back();
+        changeLoad(queue, -1);
+        return  processIndex;
+    };
+    auto queueOf = [&](const int core){ return  (cpuConfig_.perCoreQueues) ? core : 0; };
+    
+    // start a process on an idle cpu, its load moves from the source queue to the cpu's own queue
+    // the process runs after the switch to it, its slice starts then; as on a single cpu, a switch is never
+    // preempted: the cpu becomes a preemption victim at the switch end, when its key (the slice end for SRTF) is the
+    // time it completes its work, like the key of a ready process (so the switch is always paid, & the process is
+    // warm on the cpu only once it's done)
+    auto dispatch = [&](const int core, const int processIndex){
+        BasicProcess<Time> &process = processes[processIndex];
+        Cpu &cpu = cpus[core];
+        cpu.switchStart  = cpuCycle;
+        cpu.segmentStart = cpuCycle + switchCost(processIndex, core);
+        if (not process.started){ // set response time if first time running
+            process.responseTime = cpu.segmentStart - process.arrivalTime;
+            process.started = true;
+        }
+        Time slice = process.remainingTime;
+        if (roundRobin  and  timeQuantum_ < slice)  slice = timeQuantum_;
+        
+        cpu.process      = processIndex;
+        cpu.slice        = slice;
+        cpu.sliceEnd     = cpu.segmentStart + slice;
+        cpu.completes    = (slice == process.remainingTime);
+        ++cpu.version;
+        
+        coreEvents.push_back(CoreEvent{cpu.sliceEnd, core, cpu.version, false});
+        std::push_heap(coreEvents.begin(), coreEvents.end(), laterEvent);
+        idleCores.erase(core);
+        changeLoad(queueOf(core), +1);
+        if (not preemptive)  return;
+        if (cpu.segmentStart > cpuCycle){
+            coreEvents.push_back(CoreEvent{cpu.segmentStart, core, cpu.version, true});
+            std::push_heap(coreEvents.begin(), coreEvents.end(), laterEvent);
+        }
+        else if (not cpuConfig_.perCoreQueues)  runningKeys.insert({runningKey(core), core});
+    };
+    auto switching = [&](const int core){ return  cpus[core].segmentStart > cpuCycle; };
+    // take the process off the cpu at the current cpu cycle (after its switch), returns the process index
+    auto stop = [&](const int core){
+        Cpu &cpu = cpus[core];
+        BasicProcess<Time> &process = processes[cpu.process];
+        if (preemptive  and  not cpuConfig_.perCoreQueues)  runningKeys.erase({runningKey(core), core});
+        
+        if (cpu.segmentStart > cpu.switchStart){ // add the switch & this slice to the Gantt chart
+            addSegment(process.id, cpu.switchStart, cpu.segmentStart, core, true);
+        }
+        if (cpuCycle > cpu.segmentStart){
+            addSegment(process.id, cpu.segmentStart, cpuCycle, core);
+        }
+        // a whole slice is taken off as it is, (end - start) of double times may differ from it in the last bit,
+        // and a rounding residue of double times is no work left
+        if (cpu.completes  and  cpuCycle == cpu.sliceEnd)  process.remainingTime = 0;
+        else if (cpuCycle == cpu.sliceEnd)  process.remainingTime -= cpu.slice;
+        else if (cpuCycle > cpu.segmentStart)  process.remainingTime -= cpuCycle - cpu.segmentStart;
+        if (process.remainingTime < tolerance)  process.remainingTime = 0;
+        if (process.remainingTime > 0)  PROFILE_COUNT(counters_.preemptions);
+        
+        int processIndex = cpu.process;
+        cpu.process = -1;
+        ++cpu.version; // its pending slice end is stale now
+        idleCores.insert(core);
+        changeLoad(queueOf(core), -1);
+        return  processIndex;
+    };
+    // dispatch the best ready process of the queue on the cpu
+    auto dispatchFrom = [&](const int core, const int queue){ dispatch(core, popReady(queue)); };
+    
+    while (true){
+        
+        if (not checkpoint())  return; // cancelled (no checkpoints are taken in multi-cpu runs)
+        
+        // skip the slice ends of preempted processes
+        while (not coreEvents.empty()  and  coreEvents.front().version != cpus[coreEvents.front().core].version){
+            std::pop_heap(coreEvents.begin(), coreEvents.end(), laterEvent);
+            coreEvents.pop_back();
+        }
+        Time nextArrivalTime = (state_.arrivedProcessIndex < totalProcesses) ?
+                                 processes[arrivalOrder_[state_.arrivedProcessIndex]].arrivalTime :
+                                 TimeTraits<Time>::never();
+        Time nextSliceEnd = (coreEvents.empty()) ? TimeTraits<Time>::never() : coreEvents.front().time;
+        
+        if (nextArrivalTime == TimeTraits<Time>::never()  and  coreEvents.empty())  break; // all done
+        cpuCycle = std::min(nextArrivalTime, nextSliceEnd);
+        touchedQueues.clear();
+        unfinishedSlices.clear();
+        
+        // 1. the slices ending now, completed processes are calculated
+        while (not coreEvents.empty()  and  coreEvents.front().time == cpuCycle){
+            CoreEvent event = coreEvents.front();
+            std::pop_heap(coreEvents.begin(), coreEvents.end(), laterEvent);
+            coreEvents.pop_back();
+            if (event.version != cpus[event.core].version)  continue; // stale
+            if (event.switchEnd){ // the process can be preempted from now on
+                if (not cpuConfig_.perCoreQueues)  runningKeys.insert({runningKey(event.core), event.core});
+                touchedQueues.push_back(queueOf(event.core));
+                continue;
+            }
+            
+            int processIndex = stop(event.core);
+            BasicProcess<Time> &process = processes[processIndex];
+            touchedQueues.push_back(queueOf(event.core)); // its cpu is free now
+            if (process.remainingTime > 0){ unfinishedSlices.push_back({event.core, processIndex}); }
+            else { // process completed
+                process.completionTime = cpuCycle;
+                process.turnaroundTime = process.completionTime - process.arrivalTime;
+                process.waitingTime    = process.turnaroundTime - process.burstTime;
+                // response time is already set
+            }
+        }
+        // 2. the newly arrived processes join their run queue
+        while (state_.arrivedProcessIndex < totalProcesses  and
+                processes[arrivalOrder_[state_.arrivedProcessIndex]].arrivalTime <= cpuCycle){
+            int processIndex = arrivalOrder_[state_.arrivedProcessIndex++];
+            int queue = 0;
+            if (cpuConfig_.perCoreQueues){
+                queue = (cpuConfig_.loadBalancing) ? queueLoads.begin()->second : processIndex % cores;
+            }
+            pushReady(queue, processIndex);
+            touchedQueues.push_back(queue);
+        }
+        // 3. the unfinished round-robin slices go back to the end of their queue (after the arrivals)
+        for (const auto &slice : unfinishedSlices){
+            pushReady(queueOf(slice.first), slice.second);
+            touchedQueues.push_back(queueOf(slice.first));
+        }
+        // 4. the idle cpus take the work of their queue, or steal it from the longest queue
+        if (not cpuConfig_.perCoreQueues){
+            while (not idleCores.empty()  and  not readyQueues[0].empty()){ dispatchFrom(*idleCores.begin(), 0); }
+        }
+        else {
+            for (int queue : touchedQueues){
+                if (idleCores.count(queue)  and  not readyQueues[queue].empty())  dispatchFrom(queue, queue);
+            }
+            // the queue of every idle cpu is empty now, so they steal from the busiest queue with waiting work,
+            // only while both are left (no scan of the idle cpus when there's nothing to steal)
+            while (cpuConfig_.workStealing  and  not idleCores.empty()  and  not waitingLoads.empty()){
+                dispatchFrom(*idleCores.begin(), waitingLoads.rbegin()->second);
+            }
+        }
+        // 5. preemption, a better ready process replaces the worst running one
+        if (preemptive  and  not cpuConfig_.perCoreQueues){
+            while (not readyQueues[0].empty()  and  not runningKeys.empty()  and
+                    readyKey(readyQueues[0].front()) < runningKeys.rbegin()->first){
+                int victimCore = runningKeys.rbegin()->second;
+                pushReady(0, stop(victimCore));
+                dispatchFrom(victimCore, 0);
+            }
+        }
+        else if (preemptive){
+            for (int queue : touchedQueues){
+                if (cpus[queue].process >= 0  and  not switching(queue)  and  not readyQueues[queue].empty()  and
+                    readyKey(readyQueues[queue].front()) < runningKey(queue)){
+                    pushReady(queue, stop(queue));
+                    dispatchFrom(queue, queue);
+                }
+            }
+        }
+    }
 }
 
 
-#endif // __Results__
\ No newline at end of file
+// programs linked with the engine library (see CMakeLists.txt) take both engines from it (Engine.cc),
+// instead of instantiating them again in each of their translation units
+#ifdef SCHEDULER_ENGINE_LIBRARY
+extern template class BasicSchedulingEngine<double>;
+extern template class BasicSchedulingEngine<std::int64_t>;
+#endif
+
+
+#endif // __Results__
@@ -0,0 +1,95 @@
+#ifndef __ScheduleApi__
+#define __ScheduleApi__
+
+
+#include <Wt/WResource.h>
+#include <Wt/Http/Request.h>
+#include <Wt/Http/Response.h>
+
+#include <string>
+#include <vector>
+#include <algorithm>
+
+#include "Engine.hpp"
+#include "ScheduleRequest.hpp"
+
+
+// POST /api/schedule of the server (not of a session): simulates the workload & policy of a JSON request, and
+// answers the schedule & its statistics as JSON, without any session or widget
+//
+//   request    { "algorithm": "RR", "quantum": 2, "cpus": 1, "runQueues": "shared" | "per-cpu" | "balanced" | "stealing",
+//                "mlfq": { "levels", "boostInterval" }, "cfs": { "targetLatency", "minGranularity" },
+//                "io": { "devices", "discipline": "fcfs" | "shortest" | "priority" }, "horizon", "lotterySeed",
+//                "switchCosts": { "contextSwitch", "migration", "cacheWarmup" }, "segments": true, "window": { "from", "to" },
+//                "processes": [ { "processId", "arrival", "burst", "priority", "burst2", "io", "period", "deadline" } ] }
+//              only "algorithm" & "processes" are required, the rest have the defaults of the UI
+//   response   { "algorithm", "segments": [ { "processId", "start", "end", "cpu", "overhead" } ] (unless "segments": false),
+//                "processes": [ the per-process fields of the statistics export ], "summary": { ... },
+//                "window": { "from", "to", "busyTime", "cpuUtilization" } (if given: only its segments are answered) }
+//              or { "error": "..." } with status 400 (also above the limits of ScheduleRequest, e.g. a horizon or a
+//              quantum that makes millions of events), 405: not a POST, 413: more than maxBodySize bytes
+//
+// every server thread keeps its own engine & buffers between requests, so a request allocates nothing once the
+// thread has seen one as large, and the threads share nothing
+class ScheduleApiResource : public Wt::WResource {
+    
+    static const std::size_t maxBodySize = 16 << 20;
+    
+    struct Buffers {                           // of a server thread
+        std::string           body;
+        std::string           output;
+        std::string           key;
+        std::string           text;            // string values of the request
+        std::vector<Process>  processes;
+        SchedulingEngine      engine;
+        
+        Buffers(){ engine.setCheckpointing(false); }  // unrelated requests never share a prefix
+    };
+    static void sendError(Wt::Http::Response &response, const int &status, const std::string &message){
+        response.setStatus(status);
+        response.setMimeType("application/json");
+        response.out() << "{\"error\":\"" << message << "\"}\n";
+    }
+    
+    public:
+    ~ScheduleApiResource(){ beingDeleted(); }
+    
+    void handleRequest(const Wt::Http::Request &request, Wt::Http::Response &response) override {
+        
+        if (request.method() != "POST"){
+            response.addHeader("Allow", "POST");
+            sendError(response, 405, "POST a JSON request");
+            return;
+        }
+        static thread_local Buffers buffers;
+        
+        // the whole body, into the buffer of the thread (in blocks, if the length isn't known beforehand)
+        std::string &body = buffers.body;
+        std::istream &in = request.in();
+        std::size_t length = (request.contentLength() > 0) ? static_cast<std::size_t>(request.contentLength()) : 0;
+        body.clear();
+        while (body.size() <= maxBodySize  and  in){
+            std::size_t size = body.size();
+            body.resize(size + std::max<std::size_t>(length - std::min(length, size), 1 << 16));
+            in.read(&body[size], body.size() - size);
+            body.resize(size + in.gcount());
+        }
+        if (body.size() > maxBodySize){ sendError(response, 413, "request too large");  return; }
+        
+        ScheduleRequest schedule;
+        JsonReader json(body, buffers.key);
+        if (not schedule.read(json, buffers.text, buffers.processes)){ sendError(response, 400, json.error());  return; }
+        if (const char *invalid = schedule.invalid(buffers.processes)){ sendError(response, 400, invalid);  return; }
+        
+        SchedulingEngine &engine = buffers.engine;
+        schedule.configure(engine);
+        engine.simulate(buffers.processes, schedule.algorithm, schedule.quantum, schedule.cpuConfig);
+        
+        schedule.writeResponse(buffers.output, engine);
+        response.setMimeType("application/json");
+        response.out().write(buffers.output.data(), buffers.output.size());
+    }
+};
+
+
+#endif // __ScheduleApi__
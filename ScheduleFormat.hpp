@@ -0,0 +1,297 @@
+#ifndef __ScheduleFormat__
+#define __ScheduleFormat__
+
+
+#include <vector>
+#include <string>
+#include <istream>
+#include <ostream>
+#include <cstdint>
+#include <cmath>
+#include <functional>
+#include <type_traits>
+
+#include "Engine.hpp"
+
+
+// compact binary archive of a schedule, for offline analysis of very long runs
+// every time is stored as an integer no. of ticks (ticksPerUnit of them make one time unit),
+// and every integer as a LEB128 varint (zigzag encoded when it can be negative):
+//
+//   header     "PSCH", version, flags (bit 0: the segments carry a core, bit 1: an overhead bit), ticksPerUnit
+//   segments   one record per segment, in the order they end, each one relative to the previous segment:
+//                  (processId - previous processId) * 2 + (1 if it starts after an idle gap), [core,]
+//                  (with the overhead bit, the processId delta is * 2 + 1 for a switch before the gap bit is added)
+//                  [startTime - end of the previous segment on the core,] length - previous length
+//              a busy cpu has no gaps & most slices are as long as the quantum, so those two cost 1 byte
+//   processes  one record per process (the per-job statistics), in the order of the input:
+//                  id - previous id, priority, arrivalTime - previous arrivalTime, burstTime, burstTime2, ioTime,
+//                  turnaroundTime, (turnaroundTime - burstTime - burstTime2 - ioTime) - waitingTime,
+//                  waitingTime - responseTime (the last two are 0 for most processes)
+//   footer     segment count, process count & byte offset of the processes, as fixed 8 byte little endian
+//              integers, then "PSCE"; so a reader can seek straight to the statistics
+//
+// a typical segment takes 2 - 4 bytes, so a schedule of millions of segments stays within a few MB
+namespace ScheduleFormat {
+    const char          headerMagic[4]  = { 'P', 'S', 'C', 'H' };
+    const char          footerMagic[4]  = { 'P', 'S', 'C', 'E' };
+    const unsigned char version         = 1;
+    const unsigned char multiCpuFlag    = 1;
+    const unsigned char overheadFlag    = 2;
+    const std::size_t   footerSize      = 3 * 8 + 4;
+    
+    inline std::uint64_t zigzag(const std::int64_t &value){
+        return (static_cast<std::uint64_t>(value) << 1) ^ static_cast<std::uint64_t>(value >> 63);
+    }
+    inline std::int64_t unzigzag(const std::uint64_t &value){
+        return static_cast<std::int64_t>(value >> 1) ^ -static_cast<std::int64_t>(value & 1);
+    }
+    inline void putVarint(std::string &buffer, std::uint64_t value){
+        while (value >= 0x80){
+            buffer.push_back(static_cast<char>((value & 0x7f) | 0x80));
+            value >>= 7;
+        }
+        buffer.push_back(static_cast<char>(value));
+    }
+    inline void putFixed(std::string &buffer, std::uint64_t value){
+        for (int i = 0; i < 8; ++i, value >>= 8){ buffer.push_back(static_cast<char>(value & 0xff)); }
+    }
+    inline bool getVarint(std::istream &in, std::uint64_t &value){
+        value = 0;
+        for (int shift = 0; shift < 64; shift += 7){
+            int byte = in.get();
+            if (byte == std::char_traits<char>::eof())  return false;
+            value |= static_cast<std::uint64_t>(byte & 0x7f) << shift;
+            if (not (byte & 0x80))  return true;
+        }
+        return false; // more than 10 bytes: corrupt
+    }
+    inline bool getSigned(std::istream &in, std::int64_t &value){
+        std::uint64_t encoded;
+        if (not getVarint(in, encoded))  return false;
+        value = unzigzag(encoded);
+        return true;
+    }
+    inline bool getFixed(std::istream &in, std::uint64_t &value){
+        unsigned char bytes[8];
+        if (not in.read(reinterpret_cast<char *>(bytes), 8))  return false;
+        value = 0;
+        for (int i = 7; i >= 0; --i){ value = (value << 8) | bytes[i]; }
+        return true;
+    }
+}
+
+
+// encodes the segments of a run while it is simulated (see setSegmentSink), and the processes after it
+// the bytes are written to the stream in blocks, so memory stays constant however long the schedule is
+template <typename Time>
+class BasicScheduleWriter {
+    
+    std::ostream               &out_;
+    std::string                 buffer_;          // encoded bytes not yet written to out_
+    std::int64_t                ticksPerUnit_;    // ticks in one time unit of the archive
+    bool                        multiCpu_;        // the segments carry a core
+    bool                        overheads_;       // the segments carry an overhead bit
+    std::vector<std::int64_t>   laneEnds_;        // end of the last segment on each core
+    std::int64_t                previousId_;      // process id of the last segment
+    std::int64_t                previousLength_;  // length of the last segment
+    std::uint64_t               segmentCount_;
+    std::uint64_t               bytesWritten_;    // bytes already written to out_
+    bool                        finished_;
+    
+    // double times are rounded to the nearest tick, integer times are ticks already
+    std::int64_t toTicks(const Time &time) const {
+        if (std::is_integral<Time>::value)  return static_cast<std::int64_t>(time);
+        return std::llround(static_cast<double>(time) * ticksPerUnit_);
+    }
+    void flush(){
+        out_.write(buffer_.data(), buffer_.size());
+        bytesWritten_ += buffer_.size();
+        buffer_.clear();
+    }
+    
+    public:
+    // ticksPerUnit: resolution of double times, or the ticks of one unit (metadata only) for integer times
+    // overheads: the run charges switch costs (see SwitchCostConfig), so some segments are switches
+    BasicScheduleWriter(std::ostream &out, const std::int64_t &ticksPerUnit = (std::is_integral<Time>::value) ? 1 : 1000,
+                        const bool &multiCpu = false, const bool &overheads = false)
+        : out_(out), ticksPerUnit_(ticksPerUnit), multiCpu_(multiCpu), overheads_(overheads), laneEnds_(1, 0),
+          previousId_(0), previousLength_(0), segmentCount_(0), bytesWritten_(0), finished_(false) {
+        
+        buffer_.append(ScheduleFormat::headerMagic, 4);
+        buffer_.push_back(static_cast<char>(ScheduleFormat::version));
+        buffer_.push_back(static_cast<char>(((multiCpu_) ? ScheduleFormat::multiCpuFlag : 0) |
+                                            ((overheads_) ? ScheduleFormat::overheadFlag : 0)));
+        ScheduleFormat::putVarint(buffer_, ticksPerUnit_);
+    }
+    
+    void write(const BasicGanttSegment<Time> &segment){
+        int core = (multiCpu_) ? segment.core : 0;
+        if (core >= static_cast<int>(laneEnds_.size()))  laneEnds_.resize(core + 1, 0);
+        
+        std::int64_t start = toTicks(segment.startTime), end = toTicks(segment.endTime);
+        std::int64_t gap = start - laneEnds_[core];
+        std::uint64_t id = ScheduleFormat::zigzag(segment.processId - previousId_);
+        if (overheads_)  id = (id << 1) | segment.overhead;
+        ScheduleFormat::putVarint(buffer_, (id << 1) | (gap != 0));
+        if (multiCpu_)  ScheduleFormat::putVarint(buffer_, core);
+        if (gap != 0)   ScheduleFormat::putVarint(buffer_, ScheduleFormat::zigzag(gap));
+        ScheduleFormat::putVarint(buffer_, ScheduleFormat::zigzag(end - start - previousLength_));
+        
+        laneEnds_[core] = end;
+        previousId_ = segment.processId;
+        previousLength_ = end - start;
+        ++segmentCount_;
+        if (buffer_.size() >= (1 << 16))  flush();
+    }
+    
+    // appends the per-job statistics & the footer, nothing can be written afterwards
+    void finish(const std::vector<BasicProcess<Time>> &processes){
+        if (finished_)  return;
+        finished_ = true;
+        
+        std::uint64_t processOffset = bytesWritten_ + buffer_.size();
+        std::int64_t previousId = 0, previousArrival = 0;
+        for (const auto &process : processes){
+            std::int64_t arrival = toTicks(process.arrivalTime), turnaround = toTicks(process.turnaroundTime);
+            std::int64_t burst = toTicks(process.burstTime), burst2 = toTicks(process.burstTime2), io = toTicks(process.ioTime);
+            std::int64_t waiting = toTicks(process.waitingTime);
+            ScheduleFormat::putVarint(buffer_, ScheduleFormat::zigzag(process.id - previousId));
+            ScheduleFormat::putVarint(buffer_, ScheduleFormat::zigzag(process.priority));
+            ScheduleFormat::putVarint(buffer_, ScheduleFormat::zigzag(arrival - previousArrival));
+            ScheduleFormat::putVarint(buffer_, ScheduleFormat::zigzag(burst));
+            ScheduleFormat::putVarint(buffer_, ScheduleFormat::zigzag(burst2));
+            ScheduleFormat::putVarint(buffer_, ScheduleFormat::zigzag(io));
+            ScheduleFormat::putVarint(buffer_, ScheduleFormat::zigzag(turnaround));
+            ScheduleFormat::putVarint(buffer_, ScheduleFormat::zigzag(turnaround - burst - burst2 - io - waiting));
+            ScheduleFormat::putVarint(buffer_, ScheduleFormat::zigzag(waiting - toTicks(process.responseTime)));
+            previousId = process.id;
+            previousArrival = arrival;
+            if (buffer_.size() >= (1 << 16))  flush();
+        }
+        ScheduleFormat::putFixed(buffer_, segmentCount_);
+        ScheduleFormat::putFixed(buffer_, processes.size());
+        ScheduleFormat::putFixed(buffer_, processOffset);
+        buffer_.append(ScheduleFormat::footerMagic, 4);
+        flush();
+        out_.flush();
+    }
+    
+    std::uint64_t segmentCount() const { return segmentCount_; }
+    std::uint64_t bytesWritten() const { return bytesWritten_ + buffer_.size(); }
+};
+using ScheduleWriter     = BasicScheduleWriter<double>;
+using TickScheduleWriter = BasicScheduleWriter<std::int64_t>;
+
+
+// simulates the processes while streaming the schedule to out, the engine keeps no segments meanwhile
+// returns the no. of bytes written (0 if the run was cancelled, then the archive is incomplete)
+template <typename Time>
+inline std::uint64_t writeSchedule(std::ostream &out, BasicSchedulingEngine<Time> &engine,
+                                   const std::vector<BasicProcess<Time>> &processes, const std::string &algorithm,
+                                   const Time &timeQuantum, const CpuConfig &cpuConfig = CpuConfig(),
+                                   const std::int64_t &ticksPerUnit = (std::is_integral<Time>::value) ? 1 : 1000){
+    
+    bool multiCpu = cpuConfig.cores > 1  and  BasicSchedulingEngine<Time>::supportsMultiCpu(algorithm);
+    BasicScheduleWriter<Time> writer(out, ticksPerUnit, multiCpu, engine.switchCostConfig().any());
+    
+    engine.setSegmentSink([&writer](const BasicGanttSegment<Time> &segment){ writer.write(segment); });
+    engine.simulate(processes, algorithm, timeQuantum, cpuConfig);
+    engine.setSegmentSink(nullptr);
+    
+    if (engine.cancelled())  return 0;
+    writer.finish(engine.processes());
+    return writer.bytesWritten();
+}
+
+
+struct ScheduleArchive { // contents of an archive, times in units (ticks / ticksPerUnit)
+    std::int64_t          ticksPerUnit;
+    bool                  multiCpu;
+    bool                  overheads;   // some segments are switches (GanttSegment::overhead)
+    std::uint64_t         segmentCount;
+    std::vector<Process>  processes;   // completionTime = arrivalTime + turnaroundTime
+    
+    ScheduleArchive() : ticksPerUnit(1), multiCpu(false), overheads(false), segmentCount(0) {}
+};
+
+
+// reads an archive written by a ScheduleWriter, from the current position of a seekable stream up to its end
+// returns false if it is not a valid archive
+// the segments are decoded one by one into onSegment; without it they are skipped & only the statistics are read
+inline bool readSchedule(std::istream &in, ScheduleArchive &archive,
+                         const std::function<void(const GanttSegment &)> &onSegment = nullptr){
+    
+    using namespace ScheduleFormat;
+    archive = ScheduleArchive();
+    std::streampos archiveStart = in.tellg(); // offsets are relative to it
+    
+    // header
+    char magic[4];
+    if (not in.read(magic, 4)  or  std::string(magic, 4) != std::string(headerMagic, 4))  return false;
+    int fileVersion = in.get(), flags = in.get();
+    std::uint64_t ticksPerUnit;
+    if (fileVersion != version  or  flags == std::char_traits<char>::eof()  or  (flags & ~(multiCpuFlag | overheadFlag))  or
+        not getVarint(in, ticksPerUnit)  or  ticksPerUnit == 0)  return false;
+    archive.ticksPerUnit = ticksPerUnit;
+    archive.multiCpu     = flags & multiCpuFlag;
+    archive.overheads    = flags & overheadFlag;
+    std::streampos segmentsStart = in.tellg();
+    
+    // footer
+    std::uint64_t processCount, processOffset;
+    if (not in.seekg(-static_cast<std::streamoff>(footerSize), std::ios::end)  or
+        not getFixed(in, archive.segmentCount)  or  not getFixed(in, processCount)  or  not getFixed(in, processOffset)  or
+        not in.read(magic, 4)  or  std::string(magic, 4) != std::string(footerMagic, 4))  return false;
+    
+    double unit = static_cast<double>(archive.ticksPerUnit);
+    if (onSegment){
+        in.seekg(segmentsStart);
+        std::vector<std::int64_t> laneEnds(1, 0);
+        std::int64_t processId = 0, length = 0;
+        for (std::uint64_t i = 0; i < archive.segmentCount; ++i){
+            std::uint64_t idAndGap, core = 0;
+            std::int64_t gap = 0, lengthDelta;
+            if (not getVarint(in, idAndGap)  or  (archive.multiCpu  and  not getVarint(in, core))  or
+                ((idAndGap & 1)  and  not getSigned(in, gap))  or  not getSigned(in, lengthDelta))  return false;
+            if (core >= laneEnds.size())  laneEnds.resize(core + 1, 0);
+            
+            bool overhead = archive.overheads  and  (idAndGap & 2);
+            processId += unzigzag(idAndGap >> ((archive.overheads) ? 2 : 1));
+            length    += lengthDelta;
+            std::int64_t start = laneEnds[core] + gap, end = start + length;
+            laneEnds[core] = end;
+            onSegment(GanttSegment(processId, start / unit, end / unit, core, overhead));
+        }
+    }
+    
+    // per-job statistics
+    in.seekg(archiveStart + static_cast<std::streamoff>(processOffset));
+    archive.processes.resize(processCount);
+    std::int64_t id = 0, arrival = 0;
+    for (auto &process : archive.processes){
+        std::int64_t idDelta, priority, arrivalDelta, burst, burst2, io, turnaround, unaccounted, unresponsive;
+        if (not getSigned(in, idDelta)  or  not getSigned(in, priority)  or  not getSigned(in, arrivalDelta)  or
+            not getSigned(in, burst)  or  not getSigned(in, burst2)  or  not getSigned(in, io)  or
+            not getSigned(in, turnaround)  or  not getSigned(in, unaccounted)  or  not getSigned(in, unresponsive))  return false;
+        std::int64_t waiting  = turnaround - burst - burst2 - io - unaccounted;
+        std::int64_t response = waiting - unresponsive;
+        
+        id += idDelta;
+        arrival += arrivalDelta;
+        process.id             = id;
+        process.priority       = priority;
+        process.arrivalTime    = arrival / unit;
+        process.burstTime      = burst / unit;
+        process.burstTime2     = burst2 / unit;
+        process.ioTime         = io / unit;
+        process.turnaroundTime = turnaround / unit;
+        process.responseTime   = response / unit;
+        process.waitingTime    = waiting / unit;
+        process.completionTime = (arrival + turnaround) / unit;
+    }
+    return true;
+}
+
+
+#endif // __ScheduleFormat__
@@ -0,0 +1,141 @@
+#ifndef __ScheduleIndex__
+#define __ScheduleIndex__
+
+
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+#include <algorithm>
+
+#include "Engine.hpp"
+
+
+// immutable index over the gantt segments of a schedule, for time-window, point & per-process queries
+// (e.g. zooming into a huge gantt chart, or the utilization of a window) without scanning all segments
+// the segments of each cpu are stored in start order as flat arrays; as a cpu runs one process at a time,
+// its end times are in order too, so a window is one contiguous range per cpu found by two binary searches,
+// and prefix sums of the lengths give the busy time of a window without visiting its segments
+// queries report positions in the vector the index was built from (which must not overlap on a cpu)
+template <typename Time>
+class BasicScheduleIndex {
+    
+    std::vector<std::size_t>    coreBegin_;     // first entry of each cpu in the arrays below, + the end
+    std::vector<Time>           starts_;        // start times, cpu by cpu, each cpu in start order
+    std::vector<Time>           ends_;          // end times, same order
+    std::vector<Time>           busyPrefix_;    // total length of the entries before each one (+ of all)
+    std::vector<std::uint32_t>  positions_;     // position of each entry in the indexed vector
+    std::vector<int>            processIds_;    // process ids in increasing order (ties in start order)
+    std::vector<std::uint32_t>  processOrder_;  // positions in the same order
+    
+    // entries [first, last) of the cpu that overlap [from, to)
+    void coreWindow(const int &core, const Time &from, const Time &to, std::size_t &first, std::size_t &last) const {
+        auto begin = coreBegin_[core], end = coreBegin_[core + 1];
+        first = std::upper_bound(ends_.begin() + begin, ends_.begin() + end, from) - ends_.begin();
+        last  = std::lower_bound(starts_.begin() + first, starts_.begin() + end, to) - starts_.begin();
+    }
+    
+    public:
+    explicit BasicScheduleIndex(const std::vector<BasicGanttSegment<Time>> &segments = {}){
+        
+        std::size_t n = segments.size();
+        int cores = 1;
+        for (const auto &segment : segments){ cores = std::max(cores, segment.core + 1); }
+        
+        // counting sort by cpu, keeps the order of the segments of each cpu
+        coreBegin_.assign(cores + 1, 0);
+        for (const auto &segment : segments){ ++coreBegin_[segment.core + 1]; }
+        for (int core = 0; core < cores; ++core){ coreBegin_[core + 1] += coreBegin_[core]; }
+        
+        std::vector<std::size_t> next(coreBegin_.begin(), coreBegin_.end() - 1);
+        positions_.resize(n);
+        for (std::size_t i = 0; i < n; ++i){ positions_[next[segments[i].core]++] = i; }
+        
+        // the engine adds the segments of a cpu in time order, other sources (e.g. merged schedules) may not
+        auto startsBefore = [&segments](const std::uint32_t p1, const std::uint32_t p2){
+            return  segments[p1].startTime < segments[p2].startTime;
+        };
+        for (int core = 0; core < cores; ++core){
+            auto begin = positions_.begin() + coreBegin_[core], end = positions_.begin() + coreBegin_[core + 1];
+            if (not std::is_sorted(begin, end, startsBefore))  std::stable_sort(begin, end, startsBefore);
+        }
+        
+        starts_.resize(n);
+        ends_.resize(n);
+        busyPrefix_.resize(n + 1);
+        busyPrefix_[0] = 0;
+        for (std::size_t k = 0; k < n; ++k){
+            const auto &segment = segments[positions_[k]];
+            starts_[k] = segment.startTime;
+            ends_[k]   = segment.endTime;
+            busyPrefix_[k + 1] = busyPrefix_[k] + (segment.endTime - segment.startTime);
+        }
+        
+        processOrder_ = positions_;
+        std::sort(processOrder_.begin(), processOrder_.end(), [&segments](const std::uint32_t p1, const std::uint32_t p2){
+            if (segments[p1].processId != segments[p2].processId)  return  segments[p1].processId < segments[p2].processId;
+            return  segments[p1].startTime < segments[p2].startTime;
+        });
+        processIds_.resize(n);
+        for (std::size_t k = 0; k < n; ++k){ processIds_[k] = segments[processOrder_[k]].processId; }
+    }
+    
+    std::size_t size()     const { return positions_.size(); }
+    int         cpuCount() const { return coreBegin_.size() - 1; }  // highest cpu used + 1
+    
+    // calls visit(position) for every segment that overlaps [from, to), cpu by cpu in start order
+    template <typename Visitor>
+    void forEachInWindow(const Time &from, const Time &to, Visitor visit) const {
+        for (int core = 0; core < cpuCount(); ++core){
+            std::size_t first, last;
+            coreWindow(core, from, to, first, last);
+            for (std::size_t k = first; k < last; ++k){ visit(positions_[k]); }
+        }
+    }
+    std::vector<std::size_t> window(const Time &from, const Time &to) const {
+        std::vector<std::size_t> positions;
+        forEachInWindow(from, to, [&positions](const std::size_t &position){ positions.push_back(position); });
+        return positions;
+    }
+    
+    // position of the segment running on the cpu at the given time, -1 if the cpu is idle then
+    long runningAt(const Time &time, const int &core = 0) const {
+        if (core < 0  or  core >= cpuCount())  return -1;
+        
+        auto begin = starts_.begin() + coreBegin_[core], end = starts_.begin() + coreBegin_[core + 1];
+        auto k = std::upper_bound(begin, end, time) - starts_.begin(); // first one that starts later
+        return  (k > static_cast<long>(coreBegin_[core])  and  ends_[k - 1] > time) ? static_cast<long>(positions_[k - 1]) : -1;
+    }
+    
+    // calls visit(position) for every segment of the process, in start order
+    template <typename Visitor>
+    void forEachOfProcess(const int &processId, Visitor visit) const {
+        auto range = std::equal_range(processIds_.begin(), processIds_.end(), processId);
+        for (auto k = range.first - processIds_.begin(); k < range.second - processIds_.begin(); ++k){ visit(processOrder_[k]); }
+    }
+    
+    // cpu time used by all the processes within [from, to), switch overheads included
+    // the segments inside are never visited
+    Time busyTime(const Time &from, const Time &to) const {
+        Time busy = 0;
+        for (int core = 0; core < cpuCount(); ++core){
+            std::size_t first, last;
+            coreWindow(core, from, to, first, last);
+            if (first == last)  continue;
+            
+            busy += busyPrefix_[last] - busyPrefix_[first];
+            if (starts_[first] < from)  busy -= from - starts_[first];     // clip the first one
+            if (ends_[last - 1] > to)   busy -= ends_[last - 1] - to;      // and the last one
+        }
+        return busy;
+    }
+    
+    // busy fraction (0 - 1) of the capacity of the cpus within [from, to)
+    double utilization(const Time &from, const Time &to, const int &cores = 1) const {
+        return  (to > from) ? static_cast<double>(busyTime(from, to)) / (static_cast<double>(to - from) * std::max(1, cores)) : 0;
+    }
+};
+using ScheduleIndex     = BasicScheduleIndex<double>;
+using TickScheduleIndex = BasicScheduleIndex<std::int64_t>;
+
+
+#endif // __ScheduleIndex__
@@ -0,0 +1,435 @@
+#ifndef __ScheduleRequest__
+#define __ScheduleRequest__
+
+
+#include <string>
+#include <vector>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <cmath>
+#include <climits>
+#include <limits>
+#include <algorithm>
+
+#include "Engine.hpp"
+#include "Statistics.hpp"
+#include "ScheduleIndex.hpp"
+
+
+// pull reader of a JSON document held in a null terminated buffer (which must outlive the reader), for the requests of the schedule api (see ScheduleRequest)
+// values are read in the order they come: object() & array() call back for each member / element, which must read
+// the value (or skip() it); a failed read stops the document with error() set
+class JsonReader {
+    
+    const char   *at_;        // next character
+    const char   *end_;
+    const char   *error_;     // first error, nullptr while the document is fine
+    std::string  &key_;       // buffer of the member names (reused)
+    
+    void whitespace(){ while (at_ < end_  and  (*at_ == ' '  or  *at_ == '\t'  or  *at_ == '\n'  or  *at_ == '\r')){ ++at_; } }
+    bool expect(const char &c){
+        whitespace();
+        if (at_ < end_  and  *at_ == c){ ++at_;  return true; }
+        return fail("unexpected character");
+    }
+    bool peek(const char &c){
+        whitespace();
+        return  at_ < end_  and  *at_ == c;
+    }
+    
+    public:
+    JsonReader(const std::string &document, std::string &keyBuffer)
+        : at_(document.c_str()), end_(document.c_str() + document.size()), error_(nullptr), key_(keyBuffer) {}
+    
+    bool fail(const char *message){ if (not error_)  error_ = message;  at_ = end_;  return false; }
+    const char *error() const { return error_; }
+    bool atEnd(){ whitespace();  return at_ == end_; }
+    
+    bool string(std::string &value){
+        if (not expect('"'))  return false;
+        value.clear();
+        while (at_ < end_  and  *at_ != '"'){
+            char c = *at_++;
+            if (c == '\\'  and  at_ < end_){
+                c = *at_++;
+                if (c == 'n')  c = '\n';
+                else if (c == 't')  c = '\t';
+                else if (c == 'u'){ at_ = std::min(end_, at_ + 4);  c = '?'; } // names & policies are plain ascii
+            }
+            value.push_back(c);
+        }
+        if (at_ == end_)  return fail("unterminated string");
+        ++at_;
+        return true;
+    }
+    // only the JSON syntax: -? (0 | [1-9] digits) (. digits)? ([eE] [+-]? digits)?, no inf, nan or hex as strtod has,
+    // & finite (1e400 is refused, not read as infinity)
+    bool number(double &value){
+        whitespace();
+        const char *at = at_;
+        auto digits = [&at, this](){
+            const char *first = at;
+            while (at < end_  and  *at >= '0'  and  *at <= '9'){ ++at; }
+            return  at > first;
+        };
+        if (at < end_  and  *at == '-')  ++at;
+        if (at < end_  and  *at == '0')  ++at;
+        else if (not digits())  return fail("number expected");
+        if (at < end_  and  *at == '.'){ ++at;  if (not digits())  return fail("number expected"); }
+        if (at < end_  and  (*at == 'e'  or  *at == 'E')){
+            ++at;
+            if (at < end_  and  (*at == '+'  or  *at == '-'))  ++at;
+            if (not digits())  return fail("number expected");
+        }
+        // strtod reads only the span checked above (not e.g. the hex float of "0x1p3")
+        char digitsBuffer[64];
+        std::size_t length = at - at_;
+        if (length < sizeof(digitsBuffer)){
+            std::memcpy(digitsBuffer, at_, length);
+            digitsBuffer[length] = '\0';
+            value = std::strtod(digitsBuffer, nullptr);
+        }
+        else  value = std::strtod(std::string(at_, at).c_str(), nullptr);
+        if (not std::isfinite(value))  return fail("number out of range");
+        at_ = at;
+        return true;
+    }
+    bool integer(int &value){
+        double number;
+        if (not this->number(number))  return false;
+        if (not (number >= INT_MIN  and  number <= INT_MAX)  or  number != std::floor(number))  return fail("integer expected");
+        value = static_cast<int>(number);
+        return true;
+    }
+    bool boolean(bool &value){
+        whitespace();
+        if (end_ - at_ >= 4  and  std::strncmp(at_, "true", 4) == 0){ at_ += 4;  value = true;  return true; }
+        if (end_ - at_ >= 5  and  std::strncmp(at_, "false", 5) == 0){ at_ += 5;  value = false;  return true; }
+        return fail("true or false expected");
+    }
+    template <typename Member>
+    bool object(Member member){ // member(name) for each member
+        if (not expect('{'))  return false;
+        if (peek('}')){ ++at_;  return true; }
+        
+        while (string(key_)  and  expect(':')  and  member(key_)){
+            if (not peek(','))  return expect('}');
+            ++at_;
+        }
+        return fail("invalid object");
+    }
+    template <typename Element>
+    bool array(Element element){ // element() for each element
+        if (not expect('['))  return false;
+        if (peek(']')){ ++at_;  return true; }
+        
+        while (element()){
+            if (not peek(','))  return expect(']');
+            ++at_;
+        }
+        return fail("invalid array");
+    }
+    bool skip(){ // any value
+        whitespace();
+        if (at_ == end_)  return fail("value expected");
+        if (*at_ == '{')  return object([this](const std::string &){ return skip(); });
+        if (*at_ == '[')  return array([this](){ return skip(); });
+        if (*at_ == '"'){ std::string ignored;  return string(ignored); }
+        if (*at_ == 't'  or  *at_ == 'f'){ bool ignored;  return boolean(ignored); }
+        if (end_ - at_ >= 4  and  std::strncmp(at_, "null", 4) == 0){ at_ += 4;  return true; }
+        double ignored;
+        return number(ignored);
+    }
+};
+
+
+
+// a request of POST /api/schedule (see ScheduleApiResource): everything the UI can set, read from the JSON request,
+// checked with the rules of the UI & against the limits of a server, and the JSON response of its schedule
+struct ScheduleRequest {
+    std::string       algorithm;
+    double            quantum;
+    CpuConfig         cpuConfig;
+    MlfqConfig        mlfqConfig;
+    CfsConfig         cfsConfig;
+    IoConfig          ioConfig;
+    ShareConfig       shareConfig;
+    RealTimeConfig    realTimeConfig;
+    SwitchCostConfig  switchCosts;
+    bool              segments;
+    double            windowFrom;      // only the segments overlapping [windowFrom, windowTo) are answered,
+    double            windowTo;        // & the busy time of the window (the whole schedule if windowFrom > windowTo)
+    
+    // a request above a limit is refused, so no request keeps a server thread for long
+    enum { maxProcesses = 100000,   // processes of a request
+           maxJobs      = 1000000,  // periodic releases upto the horizon (EDF & RMS)
+           maxEvents    = 2000000,  // estimated segments of the schedule (see eventEstimate())
+           maxDevices   = 4096      // i/o devices (IO)
+    };
+    
+    ScheduleRequest() : quantum(2.0), segments(true), windowFrom(1), windowTo(0) {}
+    
+    bool windowed() const { return windowFrom <= windowTo; }
+    
+    // the members of the JSON request, into the settings & the processes (text: buffer of the string values)
+    bool read(JsonReader &json, std::string &text, std::vector<Process> &processes){
+        
+        processes.clear();
+        bool read = json.object([&](const std::string &name){
+            if (name == "algorithm")  return json.string(algorithm);
+            if (name == "quantum")    return json.number(quantum);
+            if (name == "cpus")       return json.integer(cpuConfig.cores);
+            if (name == "horizon")    return json.number(realTimeConfig.horizon);
+            if (name == "segments")   return json.boolean(segments);
+            if (name == "window"){
+                windowFrom = 0;
+                windowTo   = std::numeric_limits<double>::infinity();
+                return  json.object([&](const std::string &field){
+                    if (field == "from")  return json.number(windowFrom);
+                    if (field == "to")    return json.number(windowTo);
+                    return json.skip();
+                });
+            }
+            if (name == "lotterySeed"){
+                double seed;
+                if (not json.number(seed))  return false;
+                shareConfig.lotterySeed = static_cast<std::uint64_t>(std::max(0.0, seed));
+                return true;
+            }
+            if (name == "runQueues"){
+                if (not json.string(text))  return false;
+                cpuConfig.perCoreQueues = (text != "shared");
+                cpuConfig.loadBalancing = (text == "balanced"  or  text == "stealing");
+                cpuConfig.workStealing  = (text == "stealing");
+                return  (text == "shared"  or  text == "per-cpu"  or  cpuConfig.loadBalancing)  or  json.fail("unknown run queues");
+            }
+            if (name == "mlfq"){
+                return  json.object([&](const std::string &field){
+                    if (field == "levels")         return json.integer(mlfqConfig.levels);
+                    if (field == "boostInterval")  return json.number(mlfqConfig.boostInterval);
+                    return json.skip();
+                });
+            }
+            if (name == "cfs"){
+                return  json.object([&](const std::string &field){
+                    if (field == "targetLatency")   return json.number(cfsConfig.targetLatency);
+                    if (field == "minGranularity")  return json.number(cfsConfig.minGranularity);
+                    return json.skip();
+                });
+            }
+            if (name == "io"){
+                IoConfig::Discipline discipline = IoConfig::FCFS;
+                bool read = json.object([&](const std::string &field){
+                    if (field == "devices")  return json.integer(ioConfig.devices);
+                    if (field != "discipline")  return json.skip();
+                    if (not json.string(text))  return false;
+                    if (text == "fcfs")  discipline = IoConfig::FCFS;
+                    else if (text == "shortest")  discipline = IoConfig::SHORTEST_FIRST;
+                    else if (text == "priority")  discipline = IoConfig::PRIORITY;
+                    else  return json.fail("unknown i/o discipline");
+                    return true;
+                });
+                // sized within the limit while parsing, a bigger no. of devices is refused by invalid() afterwards
+                ioConfig.disciplines.assign(std::min<int>(std::max(0, ioConfig.devices), maxDevices), discipline);
+                return read;
+            }
+            if (name == "switchCosts"){
+                return  json.object([&](const std::string &field){
+                    if (field == "contextSwitch")  return json.number(switchCosts.contextSwitch);
+                    if (field == "migration")      return json.number(switchCosts.migration);
+                    if (field == "cacheWarmup")    return json.number(switchCosts.cacheWarmup);
+                    return json.skip();
+                });
+            }
+            if (name == "processes"){
+                return  json.array([&](){
+                    if (processes.size() >= maxProcesses)  return json.fail("more than 100000 processes");
+                    processes.emplace_back();
+                    processes.back().id = processes.size(); // unless given
+                    return readProcess(json, processes.back());
+                });
+            }
+            return json.skip();
+        });
+        return  read  and  (json.atEnd()  or  json.fail("trailing characters"));
+    }
+    
+    // scheduling events (about the segments) the run would make: a few per process, & one per quantum (RR, MLFQ,
+    // STRIDE, LOTTERY), minimum granularity (CFS), priority boost (MLFQ) or periodic release (EDF & RMS) of its work;
+    // infinite when a time is
+    double eventEstimate(const std::vector<Process> &processes) const {
+        bool sliced = (algorithm == "RR"  or  algorithm == "MLFQ"  or  SchedulingEngine::isProportionalShare(algorithm));
+        double slice = (sliced) ? quantum : (algorithm == "CFS") ? cfsConfig.minGranularity : 0;
+        double events = 0, end = 0, work = 0;
+        for (const auto &process : processes){
+            double cpu = process.burstTime + process.burstTime2;
+            events += 4 + ((slice > 0) ? cpu / slice : 0);
+            end     = std::max(end, process.arrivalTime);
+            work   += cpu + process.ioTime;
+        }
+        end += work; // the last completion, at the latest (without periodic releases & switches)
+        if (algorithm == "MLFQ"  and  mlfqConfig.boostInterval > 0)  events += end / mlfqConfig.boostInterval;
+        if (SchedulingEngine::isRealTime(algorithm))  events += 2 * realTimeConfig.jobCount(processes);
+        
+        // a slice that vanishes next to the times would never move the clock
+        if (not std::isfinite(end)  or  (slice > 0  and  end / slice > 1e12))  return std::numeric_limits<double>::infinity();
+        return events;
+    }
+    
+    // the same rules as the inputs of the UI, & the limits; nullptr if the request can run
+    const char *invalid(const std::vector<Process> &processes) const {
+        if (not SchedulingEngine::isKnown(algorithm))  return "unknown algorithm";
+        if ((algorithm == "RR"  or  algorithm == "MLFQ"  or  SchedulingEngine::isProportionalShare(algorithm))  and
+            not (quantum > 0))  return "quantum must be greater than 0";
+        if (cpuConfig.cores < 1  or  cpuConfig.cores > 4096)  return "cpus must be 1 - 4096";
+        if (mlfqConfig.levels < 1  or  mlfqConfig.levels > 64)  return "mlfq levels must be 1 - 64";
+        if (not (cfsConfig.minGranularity > 0)  or  not (cfsConfig.targetLatency > 0))  return "cfs times must be greater than 0";
+        if (ioConfig.devices < 0  or  ioConfig.devices > maxDevices)  return "i/o devices must be 0 - 4096";
+        if (not (switchCosts.contextSwitch >= 0)  or  not (switchCosts.migration >= 0)  or
+            not (switchCosts.cacheWarmup >= 0))  return "switch costs cannot be negative";
+        if (not (realTimeConfig.horizon >= 0))  return "horizon cannot be negative";
+        if (windowed()  and  not (std::isfinite(windowFrom)  and  windowFrom < windowTo))  return "window must be from < to";
+        
+        bool usesPriority = (algorithm == "PR"  or  algorithm == "PRP"  or  algorithm == "IO"  or  algorithm == "CFS"  or
+                             SchedulingEngine::isProportionalShare(algorithm));
+        for (const auto &process : processes){
+            if (not (process.arrivalTime >= 0))  return "arrival cannot be negative";
+            if (not (process.burstTime > 0))  return "burst must be greater than 0";
+            if (not (process.ioTime >= 0)  or  not (process.burstTime2 >= 0))  return "io & burst2 cannot be negative";
+            if (usesPriority  and  (process.priority < 1  or  process.priority > 100))  return "priority must be 1 - 100";
+            if (not (process.period >= 0)  or  not (process.deadline >= 0))  return "period & deadline cannot be negative";
+        }
+        if (SchedulingEngine::isRealTime(algorithm)  and  not (realTimeConfig.jobCount(processes) <= maxJobs)){
+            return "horizon too long: more than 1000000 periodic jobs";
+        }
+        if (not (eventEstimate(processes) <= maxEvents))  return "schedule too long: more than 2000000 events (e.g. a small quantum)";
+        return nullptr;
+    }
+    
+    // the engine runs with the settings of the request
+    void configure(SchedulingEngine &engine) const {
+        engine.setMlfqConfig(mlfqConfig);
+        engine.setCfsConfig(cfsConfig);
+        engine.setIoConfig(ioConfig);
+        engine.setShareConfig(shareConfig);
+        engine.setRealTimeConfig(realTimeConfig);
+        engine.setSwitchCostConfig(switchCosts);
+    }
+    
+    // the JSON response of the schedule of the engine
+    // a window is looked up in a ScheduleIndex of the segments, so a client can page through a huge chart
+    void writeResponse(std::string &out, const SchedulingEngine &engine) const {
+        
+        const auto &ganttSegments = engine.ganttSegments();
+        ScheduleIndex index;
+        std::vector<std::size_t> inWindow;
+        if (windowed())  index = ScheduleIndex(ganttSegments);
+        if (windowed()  and  segments){
+            inWindow = index.window(windowFrom, windowTo);
+            std::sort(inWindow.begin(), inWindow.end()); // in the order of the schedule
+        }
+        
+        out.clear();
+        out.append("{\"algorithm\":\"");
+        out.append(algorithm);
+        out.append("\"");
+        if (segments){
+            out.append(",\"segments\":[");
+            bool first = true;
+            std::size_t count = (windowed()) ? inWindow.size() : ganttSegments.size();
+            for (std::size_t k = 0; k < count; ++k){
+                const auto &segment = ganttSegments[(windowed()) ? inWindow[k] : k];
+                out.append((first) ? "\n{" : ",\n{");
+                appendField(out, "processId", segment.processId, true);
+                appendField(out, "start", segment.startTime);
+                appendField(out, "end", segment.endTime);
+                appendField(out, "cpu", segment.core);
+                out.append((segment.overhead) ? ",\"overhead\":true}" : ",\"overhead\":false}");
+                first = false;
+            }
+            out.append("]");
+        }
+        
+        // the fields of the statistics export, & the summary of the UI
+        out.append(",\"processes\":[");
+        ScheduleStatistics statistics;
+        const auto &processes = engine.processes();
+        for (std::size_t i = 0; i < processes.size(); ++i){
+            const auto &process = processes[i];
+            out.append((i) ? ",\n{" : "\n{");
+            appendField(out, "processId", process.id, true);
+            appendField(out, "priority", process.priority);
+            appendField(out, "arrival", process.arrivalTime);
+            appendField(out, "burst", process.burstTime);
+            appendField(out, "burst2", process.burstTime2);
+            appendField(out, "io", process.ioTime);
+            appendField(out, "completion", process.completionTime);
+            appendField(out, "turnaround", process.turnaroundTime);
+            appendField(out, "waiting", process.waitingTime);
+            appendField(out, "response", process.responseTime);
+            out.push_back('}');
+            statistics.add(process, algorithm == "IO");
+        }
+        int cores = (SchedulingEngine::supportsMultiCpu(algorithm)) ? cpuConfig.cores : 1;
+        bool realTime = SchedulingEngine::isRealTime(algorithm); // the throughput is in jobs
+        if (realTime)  statistics.busyTimeFromChart(engine.ganttSegments());
+        double makespan = statistics.makespan();
+        
+        out.append("],\"summary\":{");
+        appendField(out, "averageWaiting", statistics.averageWaitingTime(), true);
+        appendField(out, "averageTurnaround", statistics.averageTurnaroundTime());
+        appendField(out, "averageResponse", statistics.averageResponseTime());
+        appendField(out, "throughput", (realTime) ? ((makespan > 0) ? engine.deadlineReport().jobs / makespan : 0) :
+                                                    statistics.throughput());
+        appendField(out, "cpuUtilization", statistics.cpuUtilization(cores));
+        appendField(out, "makespan", makespan);
+        if (realTime){
+            appendField(out, "jobs", engine.deadlineReport().jobs);
+            appendField(out, "deadlineMisses", engine.deadlineReport().deadlineMisses);
+        }
+        out.push_back('}');
+        if (windowed()){ // a window without "to" ends with the schedule
+            double scheduleEnd = windowFrom;
+            for (const auto &segment : ganttSegments){ scheduleEnd = std::max(scheduleEnd, segment.endTime); }
+            double to = (std::isfinite(windowTo)) ? windowTo : scheduleEnd;
+            out.append(",\"window\":{");
+            appendField(out, "from", windowFrom, true);
+            appendField(out, "to", to);
+            appendField(out, "busyTime", index.busyTime(windowFrom, to));
+            appendField(out, "cpuUtilization", index.utilization(windowFrom, to, cores));
+            out.push_back('}');
+        }
+        out.append("}\n");
+    }
+    
+    private:
+    static void appendNumber(std::string &out, const double &value){
+        char digits[32];
+        int length = std::snprintf(digits, sizeof(digits), "%.15g", (value == value) ? value : 0.0);
+        out.append(digits, length);
+    }
+    static void appendField(std::string &out, const char *name, const double &value, const bool &first = false){
+        if (not first)  out.push_back(',');
+        out.push_back('"');
+        out.append(name);
+        out.append("\":");
+        appendNumber(out, value);
+    }
+    static bool readProcess(JsonReader &json, Process &process){
+        return  json.object([&](const std::string &name){
+            if (name == "processId")  return json.integer(process.id);
+            if (name == "priority")   return json.integer(process.priority);
+            if (name == "arrival")    return json.number(process.arrivalTime);
+            if (name == "burst")      return json.number(process.burstTime);
+            if (name == "burst2")     return json.number(process.burstTime2);
+            if (name == "io")         return json.number(process.ioTime);
+            if (name == "period")     return json.number(process.period);
+            if (name == "deadline")   return json.number(process.deadline);
+            return json.skip();
+        });
+    }
+};
+
+
+#endif // __ScheduleRequest__
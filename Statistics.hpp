@@ -0,0 +1,82 @@
+#ifndef __Statistics__
+#define __Statistics__
+
+
+#include <cstddef>
+#include <vector>
+#include <limits>
+#include <algorithm>
+
+#include "Engine.hpp"
+#include "LatencyHistogram.hpp"
+
+
+struct ScheduleStatistics { // summed results of one or more schedules
+    std::size_t       processCount;
+    double            totalWaitingTime;
+    double            totalTurnaroundTime;
+    double            totalResponseTime;
+    double            busyTime;           // cpu time spent on the processes
+    double            firstArrivalTime;   // earliest arrival of all processes
+    double            lastCompletionTime; // latest completion of all processes
+    LatencyHistogram  waitingTimes;       // distribution of the waiting times
+    LatencyHistogram  responseTimes;      // distribution of the response times
+    
+    ScheduleStatistics() : processCount(0), totalWaitingTime(0), totalTurnaroundTime(0), totalResponseTime(0),
+                           busyTime(0), firstArrivalTime(std::numeric_limits<double>::infinity()),
+                           lastCompletionTime(0) {}
+    
+    void add(const Process &process, const bool &hasSecondBurst = false){ // a completed process (second burst: IO)
+        ++processCount;
+        totalWaitingTime    += process.waitingTime;
+        totalTurnaroundTime += process.turnaroundTime;
+        totalResponseTime   += process.responseTime;
+        busyTime            += (hasSecondBurst) ? process.burstTime + process.burstTime2 : process.burstTime;
+        firstArrivalTime     = std::min(firstArrivalTime, process.arrivalTime);
+        lastCompletionTime   = std::max(lastCompletionTime, process.completionTime);
+        waitingTimes.add(process.waitingTime);
+        responseTimes.add(process.responseTime);
+    }
+    void merge(const ScheduleStatistics &other){
+        processCount        += other.processCount;
+        totalWaitingTime    += other.totalWaitingTime;
+        totalTurnaroundTime += other.totalTurnaroundTime;
+        totalResponseTime   += other.totalResponseTime;
+        busyTime            += other.busyTime;
+        firstArrivalTime     = std::min(firstArrivalTime, other.firstArrivalTime);
+        lastCompletionTime   = std::max(lastCompletionTime, other.lastCompletionTime);
+        waitingTimes.merge(other.waitingTimes);
+        responseTimes.merge(other.responseTimes);
+    }
+    void clear(){ // keeps the histograms' counters, for reuse
+        processCount = 0;
+        totalWaitingTime = totalTurnaroundTime = totalResponseTime = busyTime = lastCompletionTime = 0;
+        firstArrivalTime = std::numeric_limits<double>::infinity();
+        waitingTimes.clear();
+        responseTimes.clear();
+    }
+    // a periodic process (EDF & RMS) runs many jobs, so the busy time of a real-time schedule is taken from its chart
+    // (without the switches, they are no work of the processes)
+    void busyTimeFromChart(const std::vector<GanttSegment> &segments){
+        busyTime = 0;
+        for (const auto &segment : segments){
+            if (not segment.overhead)  busyTime += segment.endTime - segment.startTime;
+        }
+    }
+    
+    double averageWaitingTime()    const { return (processCount) ? totalWaitingTime / processCount : 0; }
+    double averageTurnaroundTime() const { return (processCount) ? totalTurnaroundTime / processCount : 0; }
+    double averageResponseTime()   const { return (processCount) ? totalResponseTime / processCount : 0; }
+    double makespan()              const { return (processCount) ? lastCompletionTime - firstArrivalTime : 0; }
+    
+    // completed processes per time unit, from the first arrival to the last completion
+    double throughput() const { return (makespan() > 0) ? processCount / makespan() : 0; }
+    
+    // fraction (0 - 1) of the capacity of the cpus that was busy, from the first arrival to the last completion
+    double cpuUtilization(const int &cores = 1) const {
+        return (makespan() > 0) ? busyTime / (makespan() * std::max(1, cores)) : 0;
+    }
+};
+
+
+#endif // __Statistics__
@@ -5,6 +5,7 @@
 #include "Classes.hpp"
 #include <iomanip>
 #include <sstream>
+#include <algorithm>
 
 
 // update the process table UI 
@@ -56,9 +57,37 @@ inline void ProcessSchedulingCalculator::updateProcessTable(const short int &new
             priorityEdit->setRange(1, 100);
             priorityEdit->setValue(processes_[i].priority);
             
+            // Period (0: released once)
+            auto periodEdit = ith_row->elementAt(6)->addNew<WDoubleSpinBox>();
+            periodEdit->setStyleClass("form-control form-control-sm");
+            periodEdit->setRange(0, 1000);
+            periodEdit->setValue(processes_[i].period);
+            periodEdit->setDecimals(1);
+            
+            // Relative deadline (0: the period)
+            auto deadlineEdit = ith_row->elementAt(7)->addNew<WDoubleSpinBox>();
+            deadlineEdit->setStyleClass("form-control form-control-sm");
+            deadlineEdit->setRange(0, 1000);
+            deadlineEdit->setValue(processes_[i].deadline);
+            deadlineEdit->setDecimals(1);
+            
+            // every value change (arrow or key stroke) is a live mode edit
+            for (WAbstractSpinBox *edit : {static_cast<WAbstractSpinBox*>(arrivalEdit), 
+                                           static_cast<WAbstractSpinBox*>(burstEdit), 
+                                           static_cast<WAbstractSpinBox*>(ioEdit), 
+                                           static_cast<WAbstractSpinBox*>(burstEdit2), 
+                                           static_cast<WAbstractSpinBox*>(priorityEdit), 
+                                           static_cast<WAbstractSpinBox*>(periodEdit), 
+                                           static_cast<WAbstractSpinBox*>(deadlineEdit)}){
+                edit->changed().connect(this, &ProcessSchedulingCalculator::onInputEdited);
+                edit->textInput().connect(this, &ProcessSchedulingCalculator::onInputEdited);
+            }
+            
             ith_row->elementAt(3)->setId("inp-out-header" + std::to_string(i));
             ith_row->elementAt(4)->setId("execute2-header" + std::to_string(i));
             ith_row->elementAt(5)->setId("priority-row" + std::to_string(i));
+            ith_row->elementAt(6)->setId("period-row" + std::to_string(i));
+            ith_row->elementAt(7)->setId("deadline-row" + std::to_string(i));
             
             // hide/show the execute2, io, priority column based on the selected algorithm
             if (selectedAlgorithm_ == "IO"){ 
@@ -66,7 +95,8 @@ inline void ProcessSchedulingCalculator::updateProcessTable(const short int &new
                 ith_row->elementAt(4)->show(); 
                 ith_row->elementAt(5)->show();
             }
-            else if (selectedAlgorithm_ == "PR"  or  selectedAlgorithm_ == "PRP"){
+            else if (selectedAlgorithm_ == "PR"  or  selectedAlgorithm_ == "PRP"  or  selectedAlgorithm_ == "CFS"  or
+                     SchedulingEngine::isProportionalShare(selectedAlgorithm_)){
                 ith_row->elementAt(3)->hide(); 
                 ith_row->elementAt(4)->hide();
                 ith_row->elementAt(5)->show();  
@@ -76,6 +106,8 @@ inline void ProcessSchedulingCalculator::updateProcessTable(const short int &new
                 ith_row->elementAt(4)->hide(); 
                 ith_row->elementAt(5)->hide();
             }
+            ith_row->elementAt(6)->setHidden(not SchedulingEngine::isRealTime(selectedAlgorithm_));
+            ith_row->elementAt(7)->setHidden(not SchedulingEngine::isRealTime(selectedAlgorithm_));
             
         }
     }
@@ -118,10 +150,15 @@ inline void ProcessSchedulingCalculator::showAlertMessage(const std::string &mes
 // validate the input values for process input table & time quantum input
 inline bool ProcessSchedulingCalculator::validateInputs(){
     
-    if (selectedAlgorithm_ == "RR"  and  quantumSpinBox_->value() <= 0){
+    if ((selectedAlgorithm_ == "RR"  or  selectedAlgorithm_ == "MLFQ"  or  SchedulingEngine::isProportionalShare(selectedAlgorithm_))
+        and  quantumSpinBox_->value() <= 0){
         showAlertMessage("Time-Quantum value must be greater than 0.0 !", false);
         return false;
     }
+    if (coreCountSpinBox_->value() < 1){
+        showAlertMessage("At least 1 CPU is required !", false);
+        return false;
+    }
     for (short int i = 0; i < currentProcessCount_; ++i){
         auto ith_row = processTable_->rowAt(i + 1);
         
@@ -146,162 +183,388 @@ inline bool ProcessSchedulingCalculator::validateInputs(){
             return false;
         }
         auto priorityEdit = static_cast<WSpinBox*>(ith_row->elementAt(5)->widget(0));
-        if ((selectedAlgorithm_ == "PR"  or  selectedAlgorithm_ == "PRP"  or  selectedAlgorithm_ == "IO")  
+        if ((selectedAlgorithm_ == "PR"  or  selectedAlgorithm_ == "PRP"  or  selectedAlgorithm_ == "IO"  or  
+             selectedAlgorithm_ == "CFS"  or  SchedulingEngine::isProportionalShare(selectedAlgorithm_))
             and  (priorityEdit->value() <= 0  or  priorityEdit->value() > 100)){
                 showAlertMessage("Priority must be between 1 to 100 !", false);
                 return false;
         }
+        auto periodEdit   = static_cast<WDoubleSpinBox*>(ith_row->elementAt(6)->widget(0));
+        auto deadlineEdit = static_cast<WDoubleSpinBox*>(ith_row->elementAt(7)->widget(0));
+        if (SchedulingEngine::isRealTime(selectedAlgorithm_)  and  (periodEdit->value() < 0.0  or  deadlineEdit->value() < 0.0)){
+            showAlertMessage("Period & deadline cannot be negative !", false);
+            return false;
+        }
     }
     return true;
 }
 
 
-// return the actual process color to differentiate between the processes in the grantt chart
-inline std::string ProcessSchedulingCalculator::getProcessColor(const short int processId){
-    return  processColors_[(processId - 1) % processColors_.size()];
+// read the process values from the process input table into processes_
+inline void ProcessSchedulingCalculator::readProcessTable(){
+    
+    for (short int i = 0; i < currentProcessCount_; ++i) {
+        auto ith_row = processTable_->rowAt(i + 1);
+        
+        processes_[i].id = i + 1; // set the process id
+        
+        auto arrivalEdit = static_cast<WDoubleSpinBox*>(ith_row->elementAt(1)->widget(0));
+        processes_[i].arrivalTime = arrivalEdit->value(); // read arrival time
+        
+        auto burstEdit = static_cast<WDoubleSpinBox*>(ith_row->elementAt(2)->widget(0));
+        processes_[i].burstTime = burstEdit->value(); // read burst time
+        
+        auto ioEdit = static_cast<WDoubleSpinBox*>(ith_row->elementAt(3)->widget(0));
+        processes_[i].ioTime = ioEdit->value(); // read io time
+        
+        auto burstEdit2 = static_cast<WDoubleSpinBox*>(ith_row->elementAt(4)->widget(0));
+        processes_[i].burstTime2 = burstEdit2->value(); // read burst time
+        
+        auto priorityEdit = static_cast<WSpinBox*>(ith_row->elementAt(5)->widget(0));
+        processes_[i].priority = priorityEdit->value(); // read priority
+        
+        auto periodEdit = static_cast<WDoubleSpinBox*>(ith_row->elementAt(6)->widget(0));
+        processes_[i].period = periodEdit->value(); // read period
+        
+        auto deadlineEdit = static_cast<WDoubleSpinBox*>(ith_row->elementAt(7)->widget(0));
+        processes_[i].deadline = deadlineEdit->value(); // read relative deadline
+    }
+}
+
+
+// read the cpu count & the run queue layout from the algorithm configuration
+inline void ProcessSchedulingCalculator::readCpuConfig(){
+    
+    short int runQueueIndex = runQueueComboBox_->currentIndex();
+    
+    cpuConfig_.cores         = coreCountSpinBox_->value();
+    cpuConfig_.perCoreQueues = runQueueIndex >= 1;
+    cpuConfig_.loadBalancing = runQueueIndex >= 2;
+    cpuConfig_.workStealing  = runQueueIndex >= 3;
+}
+
+
+// read the levels & the boost interval of MLFQ (the time quantum is the allotment of level 0)
+inline void ProcessSchedulingCalculator::readMlfqConfig(){
+    
+    mlfqConfig_.levels        = mlfqLevelsSpinBox_->value();
+    mlfqConfig_.boostInterval = mlfqBoostSpinBox_->value();
+    mlfqConfig_.quanta.clear(); // doubled on every level
+}
+
+
+// read the target latency & the minimum granularity of CFS
+inline void ProcessSchedulingCalculator::readCfsConfig(){
+    
+    cfsConfig_.targetLatency  = cfsLatencySpinBox_->value();
+    cfsConfig_.minGranularity = cfsGranularitySpinBox_->value();
+}
+
+
+// read the no. of i/o devices & their queue discipline (same for every device)
+inline void ProcessSchedulingCalculator::readIoConfig(){
+    
+    ioConfig_.devices = ioDevicesSpinBox_->value();
+    ioConfig_.disciplines.assign(ioConfig_.devices, 
+                                 static_cast<IoConfig::Discipline>(ioDisciplineComboBox_->currentIndex()));
+}
+
+
+// read the release horizon of the periodic processes (EDF & RMS)
+inline void ProcessSchedulingCalculator::readRealTimeConfig(){
+    
+    realTimeConfig_.horizon = realTimeHorizonSpinBox_->value();
+}
+
+
+// read the costs of a switch between the processes (0 = free switches)
+inline void ProcessSchedulingCalculator::readSwitchCostConfig(){
+    
+    switchCostConfig_.contextSwitch = contextSwitchSpinBox_->value();
+    switchCostConfig_.migration     = migrationSpinBox_->value();
+    switchCostConfig_.cacheWarmup   = cacheWarmupSpinBox_->value();
 }
 
 
 // create & update the statistics values with the result
+// if the table already has a row for each process, then only the changed cells are updated
 inline void ProcessSchedulingCalculator::updateStatistics(const std::vector<Process> &processes){
     
-    // clear existing table
-    while (statisticsTable_->rowCount() > 0){ statisticsTable_->removeRow(0); }
-    
-    // create the header row
-    auto headerRow = statisticsTable_->insertRow(0);
-    headerRow->elementAt(0)->addNew<WText>("PID");  // process id
-    headerRow->elementAt(1)->addNew<WText>("AT");   // arrival time
-    headerRow->elementAt(2)->addNew<WText>("CT");   // completion time
-    headerRow->elementAt(3)->addNew<WText>("TT");   // turnaround time 
-    headerRow->elementAt(4)->addNew<WText>("WT");   // waiting time
-    headerRow->elementAt(5)->addNew<WText>("RT");   // response time
-    
-    // style header
-    for (short int i = 0; i <= 5; ++i){ 
-        headerRow->elementAt(i)->setStyleClass("text-center rounded-pill bg-secondary text-white"); 
+    PROFILE_PHASE(phaseTimings_, STATISTICS);
+    if (statisticsTable_->rowCount() != static_cast<int>(processes.size()) + 1){
+        
+        // clear existing table
+        while (statisticsTable_->rowCount() > 0){ statisticsTable_->removeRow(0); }
+        
+        // create the header row
+        auto headerRow = statisticsTable_->insertRow(0);
+        headerRow->elementAt(0)->addNew<WText>("PID");  // process id
+        headerRow->elementAt(1)->addNew<WText>("AT");   // arrival time
+        headerRow->elementAt(2)->addNew<WText>("CT");   // completion time
+        headerRow->elementAt(3)->addNew<WText>("TT");   // turnaround time 
+        headerRow->elementAt(4)->addNew<WText>("WT");   // waiting time
+        headerRow->elementAt(5)->addNew<WText>("RT");   // response time
+        
+        // style header
+        for (short int i = 0; i <= 5; ++i){ 
+            headerRow->elementAt(i)->setStyleClass("text-center rounded-pill bg-secondary text-white"); 
+        }
+        // add an empty row for each process
+        for (short int r = 1, n = processes.size(); r <= n; ++r){
+            auto ith_row = statisticsTable_->insertRow(r);
+            for (short int i = 0; i <= 5; ++i){ 
+                ith_row->elementAt(i)->addNew<WText>();
+                ith_row->elementAt(i)->setStyleClass("text-center");
+            }
+        }
     }
-    // add process data
-    double totalBurstTime = 0, totalWaitingTime = 0, totalTurnaroundTime = 0, totalResponseTime = 0;
+    // set the cell text only if it is changed, so that the unchanged rows are not sent again
+    auto setCellText = [](WTableRow *row, const short int column, const std::string &text){
+        auto cellText = static_cast<WText*>(row->elementAt(column)->widget(0));
+        if (cellText->text().toUTF8() != text){ cellText->setText(text); }
+    };
+    
+    // add process data, the summary is collected in the same pass
+    ScheduleStatistics statistics;
+    short int r = 0;
     
     for (const auto &process : processes){
-        // insert the row at the ith + 1 position every time it returns the row count
-        auto ith_row = statisticsTable_->insertRow(statisticsTable_->rowCount());
+        auto ith_row = statisticsTable_->rowAt(++r);
         std::ostringstream  at, ct, tat, wt, rt;
         
-        ith_row->elementAt(0)->addNew<WText>("P" + std::to_string(process.id));
+        setCellText(ith_row, 0, "P" + std::to_string(process.id));
         at << std::fixed << std::setprecision(1) << process.arrivalTime;
-        ith_row->elementAt(1)->addNew<WText>(at.str());
+        setCellText(ith_row, 1, at.str());
         ct << std::fixed << std::setprecision(1) << process.completionTime;
-        ith_row->elementAt(2)->addNew<WText>(ct.str());
+        setCellText(ith_row, 2, ct.str());
         tat << std::fixed << std::setprecision(1) << process.turnaroundTime;
-        ith_row->elementAt(3)->addNew<WText>(tat.str());
+        setCellText(ith_row, 3, tat.str());
         wt << std::fixed << std::setprecision(1) << process.waitingTime;
-        ith_row->elementAt(4)->addNew<WText>(wt.str());
+        setCellText(ith_row, 4, wt.str());
         rt << std::fixed << std::setprecision(1) << process.responseTime;
-        ith_row->elementAt(5)->addNew<WText>(rt.str());
-        
-        for (short int i = 0; i <= 5; ++i){ ith_row->elementAt(i)->setStyleClass("text-center"); }
+        setCellText(ith_row, 5, rt.str());
         
-        (selectedAlgorithm_ == "IO") ? 
-        totalBurstTime      += process.burstTime + process.burstTime2 : 
-        totalBurstTime      += process.burstTime;
-        totalWaitingTime    += process.waitingTime;
-        totalTurnaroundTime += process.turnaroundTime;
-        totalResponseTime   += process.responseTime;
+        statistics.add(process, selectedAlgorithm_ == "IO");
     }
     
-    // calculate averages
-    double avgBurstTime      = totalBurstTime / processes.size();
-    double avgWaitingTime    = totalWaitingTime / processes.size();
-    double avgTurnaroundTime = totalTurnaroundTime / processes.size();
-    double avgResponseTime   = totalResponseTime / processes.size();
+    // p50 / p90 / p99 / max of a distribution
+    auto percentiles = [](const LatencyHistogram &histogram){
+        std::ostringstream text;
+        text << std::fixed << std::setprecision(1) << histogram.percentile(0.50) << " / " << histogram.percentile(0.90)
+             << " / " << histogram.percentile(0.99) << " / " << histogram.max();
+        return text.str();
+    };
+    int cores = (SchedulingEngine::supportsMultiCpu(selectedAlgorithm_)) ? cpuConfig_.cores : 1; // capacity of the host
+    
+    // a periodic process runs many jobs, so the busy time is taken from the chart & the throughput is in jobs
+    bool realTime = SchedulingEngine::isRealTime(selectedAlgorithm_);
+    const DeadlineReport &deadlines = engine_.deadlineReport();
+    std::string throughput = std::to_string(statistics.throughput()) + " processes/unit";
+    if (realTime){
+        statistics.busyTimeFromChart(engine_.ganttSegments());
+        throughput = std::to_string((statistics.makespan() > 0) ? deadlines.jobs / statistics.makespan() : 0) + " jobs/unit";
+    }
     
     // update summary statistics
-    averageBurstTimeText_->setText("<h6> Throughput = "                   + 
-                                        std::to_string(avgBurstTime)      + " processes/unit </h6>");
+    throughputText_->setText("<h6> Throughput = " + throughput + " </h6>");
+    cpuUtilizationText_->setText("<h6> CPU Utilization = "                + 
+                                        std::to_string(100 * statistics.cpuUtilization(cores)) + " % </h6>");
     averageWaitingTimeText_->setText("<h6> Average Waiting Time = "       + 
-                                        std::to_string(avgWaitingTime)    + " units </h6>");
+                                        std::to_string(statistics.averageWaitingTime())    + " units </h6>");
     averageTurnaroundTimeText_->setText("<h6> Average Turnaround Time = " + 
-                                        std::to_string(avgTurnaroundTime) + " units </h6>");
+                                        std::to_string(statistics.averageTurnaroundTime()) + " units </h6>");
     averageResponseTimeText_->setText("<h6> Average Response Time = "     + 
-                                        std::to_string(avgResponseTime)   + " units </h6>");
-}
-
-
-// html design for gantt chart creation
-inline std::string ProcessSchedulingCalculator::generateGanttHTML(const std::vector<GanttSegment> &segments){
-    if (segments.empty())  return "";
-    
-    std::ostringstream html;
-    html <<"<div style='overflow-x: auto; margin: 30px 0; font-family: Arial, sans-serif;'>";
-    // Start table
-    html <<"<table style='border-collapse: separate; border-spacing: 0; width: auto;'>";
-    
-    // --- First row: processes ---
-    html << "<tr>";
-    for (const auto &segment : segments){
-        int width = (segment.endTime - segment.startTime) * 40; // adjust as space 
-        html <<"\
-        <td style='width: "<< width <<"px; height: 40px; background:"<< segment.color <<"; \
-        border: none; border-radius: 25px; text-align: center; vertical-align: middle; font-size: 15px; font-weight: bold;'> \
-            P"<< segment.processId <<" \
-        </td>";
+                                        std::to_string(statistics.averageResponseTime())   + " units </h6>");
+    waitingPercentilesText_->setText("<h6> Waiting Time p50 / p90 / p99 / max = "  + 
+                                        percentiles(statistics.waitingTimes)  + " units </h6>");
+    responsePercentilesText_->setText("<h6> Response Time p50 / p90 / p99 / max = " + 
+                                        percentiles(statistics.responseTimes) + " units </h6>");
+    
+    // the switches are not work of the processes, so the utilization above leaves them out
+    double overhead = 0, busy = statistics.busyTime;
+    std::size_t switches = 0;
+    for (const auto &segment : engine_.ganttSegments()){
+        if (segment.overhead){ overhead += segment.endTime - segment.startTime;  ++switches; }
     }
-    html << "</tr>";
-    
-    // --- Second row: edge times ---
-    html << "<tr>";
-    for (const auto &segment : segments){
-        html <<"\
-        <td style='height: 20px; border: none; background: transparent; position: relative;'> \
-            <div class='d-flex justify-content-between text-dark fs-6'> \
-                <span style='padding-left : 5px; '>"<< segment.startTime <<"</span> \
-                <span> - </span> \
-                <span style='padding-right: 5px; '>"<< segment.endTime <<"</span> \
-            </div> \
-        </td>";
-        /* same creates the gantt chart but the timings are in middle point with this line 
-        <div class='d-flex justify-content-center text-dark fs-6'> \
-        */
+    if (switches){
+        std::ostringstream text;
+        text << std::fixed << std::setprecision(1) << "<h6> Switch Overhead = " << overhead << " units in " << switches
+             << " switches (" << 100 * overhead / (busy + overhead) << " % of the busy time) </h6>";
+        overheadText_->setText(text.str());
     }
-    html << "</tr>";
-    html << "</table>";
-    html << "</div>";
+    else  overheadText_->setText("");
     
-    return html.str();
+    if (not realTime){ deadlineText_->setText("");  return; }
+    std::ostringstream text;
+    text << std::fixed << std::setprecision(1) << "<h6> Deadline Misses = " << deadlines.deadlineMisses << " of "
+         << deadlines.jobs << " jobs, Tardiness p50 / p90 / p99 / max = " << percentiles(deadlines.tardiness) << " units";
+    if (deadlines.tardiness.count())  text << ", Max Lateness = " << deadlines.maxLateness << " units";
+    text << " </h6>";
+    deadlineText_->setText(text.str());
 }
 
 
 // update the gantt chart with the given segments
-inline void ProcessSchedulingCalculator::updateGanttChart(const std::vector<GanttSegment> &segments){
+// the browser keeps the segments it has & fetches only the ones from the first changed segment on (GanttDataResource)
+inline void ProcessSchedulingCalculator::updateGanttChart(const std::vector<GanttSegment> &segments, 
+                                                          const std::size_t &firstChangedSegment){
+    PROFILE_PHASE(phaseTimings_, GANTT_UPDATE);
     if (segments.empty()){
+        ganttClientSegments_ = 0;
+        doJavaScript("SchedulerGantt.clear(" + ganttChart_->jsRef() + ");");
         ganttChartText_->setText("<h6> No processes to display. </h6>");
         return;
     }
+    // same segments as before, so the chart is already up to date
+    if (firstChangedSegment == segments.size()  and  ganttClientSegments_ == segments.size())  return;
+    
+    std::size_t from = std::min(firstChangedSegment, ganttClientSegments_);
+    ganttClientSegments_ = segments.size();
+    ganttChartText_->setText("");
+    doJavaScript("SchedulerGantt.update(" + ganttChart_->jsRef() + ", '" + ganttData_->url() + "&v=" +
+                 std::to_string(resultsVersion_) + "', " + std::to_string(from) + ");");
+}
+
+
+// show the current results of the engine
+inline void ProcessSchedulingCalculator::showResults(const std::size_t &firstChangedSegment){
+    
+    ScopedLatency latency(ServerMetrics::RENDER);
+    if (resultsContainer_->count() == 0)  setupResultsWidgets(); // first results of the session
     
-    std::string html = generateGanttHTML(segments);
-    ganttChartText_->setText(html);
+    ++resultsVersion_;
+    updateGanttChart(engine_.ganttSegments(), firstChangedSegment);
+    updateStatistics(engine_.processes());
+    updateOptimalComparison(engine_.processes());
+    showProfile();
+    resultsContainer_->show();
+}
+
+
+// the selected objective of the results next to the best non-preemptive single cpu schedule of the processes
+// the search is capped, so beyond a few dozen processes it may only bound the optimum; switch costs are left out
+// it runs on the background pool on one thread (the pool's threads are the budget of all the sessions), and only
+// when its inputs changed: switching the policy, the quantum etc. reuses the last optimum
+inline void ProcessSchedulingCalculator::updateOptimalComparison(const std::vector<Process> &processes){
+    
+    int selected = optimalComboBox_->currentIndex();
+    bool multiCpu = cpuConfig_.cores > 1  and  SchedulingEngine::supportsMultiCpu(selectedAlgorithm_);
+    if (selected <= 0  or  processes.empty()  or  SchedulingEngine::isRealTime(selectedAlgorithm_)){
+        optimalText_->setText("");
+        return;
+    }
+    if (multiCpu){ optimalText_->setText("<h6> Optimum: single CPU only </h6>");  return; }
+    
+    OptimalConfig config;
+    config.objective    = static_cast<OptimalConfig::Objective>(selected - 1);
+    config.secondBursts = (selectedAlgorithm_ == "IO");
+    config.nodeLimit    = 200000;
+    config.threadCount  = 1;
+    double value = scheduleObjective(processes, config.objective);
+    std::string objective = optimalComboBox_->currentText().toUTF8();
+    
+    // the inputs of the search, in the order of the processes
+    std::vector<double> inputs = { double(config.objective), double(config.secondBursts) };
+    inputs.reserve(2 + 5 * processes.size());
+    for (const auto &process : processes){
+        inputs.insert(inputs.end(), { process.arrivalTime, process.burstTime, double(process.priority),
+                                      process.burstTime2, process.ioTime });
+    }
+    if (inputs == optimalInputs_){ showOptimalComparison(objective, value, optimum_);  return; }
+    
+    optimalText_->setText("<h6> Optimum: calculating ... </h6>");
+    ++optimalSearches_;
+    enableUpdates(true); // server push until the search is back
+    auto version   = resultsVersion_;
+    auto sessionId = this->sessionId();
+    auto server    = WServer::instance();
+    auto inputsPtr = std::make_shared<std::vector<double>>(std::move(inputs));
+    bool posted = BackgroundPool::instance().post([=](){
+        auto optimum = std::make_shared<OptimalSchedule>(solveOptimal(processes, config));
+        server->post(sessionId, [=](){
+            --optimalSearches_;
+            enableUpdates(liveModeCheckBox_->isChecked()  or  optimalSearches_ > 0);
+            if (resultsVersion_ != version)  return; // newer results, with their own search
+            optimalInputs_ = std::move(*inputsPtr);
+            optimum_       = std::move(*optimum);
+            showOptimalComparison(objective, value, optimum_);
+            triggerUpdate();
+        });
+    });
+    if (posted)  return;
+    --optimalSearches_;
+    enableUpdates(liveModeCheckBox_->isChecked()  or  optimalSearches_ > 0);
+    optimalText_->setText("<h6> Optimum: the server is busy, calculate again later </h6>");
+}
+
+
+// the objective of the results next to the optimum
+inline void ProcessSchedulingCalculator::showOptimalComparison(const std::string &objective, const double &value, const OptimalSchedule &optimum){
+    
+    std::ostringstream text;
+    text << std::fixed << std::setprecision(1) << "<h6> " << objective << " = " << value;
+    if (optimum.optimal)  text << ", Optimum (non-preemptive) = " << optimum.value;
+    else  text << ", Optimum (non-preemptive) within " << optimum.lowerBound << " - " << optimum.value;
+    if (optimum.value > 0)  text << " (" << std::showpos << 100 * (value - optimum.value) / optimum.value << std::noshowpos << " %)";
+    text << " </h6>";
+    optimalText_->setText(text.str());
+}
+
+
+// phase timings of the session & the counters of the last run, as a short summary
+inline void ProcessSchedulingCalculator::showProfile(){
+    
+    if (not profilingEnabled)  return;
+    
+    std::ostringstream text;
+    text << std::fixed << std::setprecision(3);
+    for (int phase = 0; phase < PhaseTimings::PHASE_COUNT; ++phase){
+        const auto &timing = phaseTimings_.timings[phase];
+        double averageMs = (timing.calls) ? timing.totalNanoseconds / 1e6 / timing.calls : 0;
+        text << PhaseTimings::name(static_cast<PhaseTimings::Phase>(phase)) << ": " << averageMs << " ms avg, "
+             << timing.maxNanoseconds / 1e6 << " ms max (" << timing.calls << " calls)<br/>";
+    }
+    const EngineCounters &counters = engine_.counters();
+    text << "events " << counters.events << ", dispatches " << counters.dispatches << ", preemptions "
+         << counters.preemptions << ", queue high-water " << counters.queueHighWater << ", allocations "
+         << counters.allocations;
+    profileText_->setText(text.str());
 }
 
 
 // clear the results (gantt chart and statistics table)
+// the buffers of the results are given back too, an idle session should not hold on to the biggest run it had
 inline void ProcessSchedulingCalculator::clearResults(){
     
-    ganttSegments_.clear();
+    ++(*liveGeneration_); // results of a running live calculation are not needed anymore
+    ++resultsVersion_;
+    engine_ = SchedulingEngine();
+    ganttClientSegments_ = 0;
+    optimalInputs_.clear();
+    optimum_ = OptimalSchedule();
+    
+    alertContainer_->clear();  // clear alert container
+    resultsContainer_->hide(); // hide the result container
+    if (resultsContainer_->count() == 0)  return; // no results were shown yet
+    
     ganttChartText_->setText("");
+    doJavaScript("SchedulerGantt.clear(" + ganttChart_->jsRef() + ");");
     
     // clear statistics table
     while (statisticsTable_->rowCount() > 0){ statisticsTable_->removeRow(0); }
     
     // clear summary statistics
-    averageBurstTimeText_->setText("");
+    throughputText_->setText("");
+    cpuUtilizationText_->setText("");
     averageWaitingTimeText_->setText("");
     averageTurnaroundTimeText_->setText("");
     averageResponseTimeText_->setText("");
-    
-    alertContainer_->clear();  // clear alert container
-    resultsContainer_->hide(); // hide the result container
+    waitingPercentilesText_->setText("");
+    responsePercentilesText_->setText("");
+    deadlineText_->setText("");
+    overheadText_->setText("");
+    optimalText_->setText("");
+    profileText_->setText("");
 }
 
 
@@ -0,0 +1,170 @@
+#include "Results.hpp"
+#include <iostream>
+#include <iomanip>
+#include <sstream>
+#include <chrono>
+#include <cstdlib>
+
+
+// scheduler_bench: times the engine & its tools on seeded random workloads (the same ones on every run)
+// it is also the training run of the PGO build (see CMakeLists.txt), so every algorithm & tool the web app & the
+// api use is covered, with workloads of the sizes they see
+// usage: scheduler_bench [repetitions]   (default 5, the best & the median run are printed)
+
+struct Benchmark {
+    std::string                   name;
+    std::function<std::size_t()>  run;   // returns the segments (or other items) it produced, for the rate
+};
+
+
+static std::vector<Process> sampleWorkload(const WorkloadDistribution &distribution, const std::uint64_t &seed){
+    std::mt19937_64 random(seed);
+    std::vector<Process> processes;
+    distribution.sample(random, processes);
+    return processes;
+}
+
+
+int main(int argc, char *argv[]){
+    
+    int repetitions = (argc > 1) ? std::max(1, std::atoi(argv[1])) : 5;
+    
+    // a single cpu at about 80 % load, the same load on 8 cpus, & processes with i/o
+    WorkloadDistribution single, smp, withIo;
+    single.processCount = smp.processCount = withIo.processCount = 20000;
+    smp.meanInterarrival = 0.625;
+    withIo.meanBurst  = 2;
+    withIo.meanBurst2 = 2;
+    withIo.meanIo     = 6;
+    const std::vector<Process> singleWorkload = sampleWorkload(single, 1), smpWorkload = sampleWorkload(smp, 2),
+                               ioWorkload = sampleWorkload(withIo, 3);
+    
+    // periodic tasks of about 90 % utilization
+    std::vector<Process> periodicWorkload(40);
+    std::mt19937_64 random(4);
+    for (std::size_t i = 0; i < periodicWorkload.size(); ++i){
+        Process &task = periodicWorkload[i];
+        task.id        = i + 1;
+        task.period    = 10 * (1 + random() % 20);
+        task.burstTime = std::max(0.1, std::round(task.period * 0.0225 * 10) / 10);
+    }
+    
+    CpuConfig eightCpus;
+    eightCpus.cores = 8;
+    SwitchCostConfig switchCosts;
+    switchCosts.contextSwitch = 0.05;
+    switchCosts.cacheWarmup   = 0.02;
+    
+    SchedulingEngine engine;       // reused like the engine of a session
+    engine.setCheckpointing(false);
+    auto simulate = [&engine](const std::vector<Process> &processes, const std::string &algorithm, const CpuConfig &cpuConfig){
+        return [&engine, &processes, algorithm, cpuConfig](){
+            engine.simulate(processes, algorithm, 2, cpuConfig);
+            return engine.ganttSegments().size();
+        };
+    };
+    
+    std::vector<Benchmark> benchmarks;
+    for (const char *algorithm : { "FCFS", "SJF", "PR", "RR", "SRTF", "PRP", "MLFQ", "CFS", "STRIDE", "LOTTERY" }){
+        benchmarks.push_back({ std::string(algorithm) + " 20k", simulate(singleWorkload, algorithm, CpuConfig()) });
+    }
+    benchmarks.push_back({ "IO 20k", simulate(ioWorkload, "IO", CpuConfig()) });
+    for (const char *algorithm : { "FCFS", "RR", "SRTF", "PRP" }){
+        benchmarks.push_back({ std::string(algorithm) + " 20k 8 cpus", simulate(smpWorkload, algorithm, eightCpus) });
+    }
+    CpuConfig stealing = eightCpus;
+    stealing.perCoreQueues = stealing.loadBalancing = stealing.workStealing = true;
+    benchmarks.push_back({ "SRTF 20k 8 cpus stealing", simulate(smpWorkload, "SRTF", stealing) });
+    
+    RealTimeConfig realTime;
+    realTime.horizon = 100000;
+    for (const char *algorithm : { "EDF", "RMS" }){
+        benchmarks.push_back({ std::string(algorithm) + " 40 tasks", [&engine, &periodicWorkload, realTime, algorithm](){
+            engine.setRealTimeConfig(realTime);
+            engine.simulate(periodicWorkload, algorithm, 2);
+            engine.setRealTimeConfig(RealTimeConfig());
+            return engine.ganttSegments().size();
+        } });
+    }
+    benchmarks.push_back({ "RR 20k switch costs", [&engine, &singleWorkload, switchCosts](){
+        engine.setSwitchCostConfig(switchCosts);
+        engine.simulate(singleWorkload, "RR", 2);
+        engine.setSwitchCostConfig(SwitchCostConfig());
+        return engine.ganttSegments().size();
+    } });
+    
+    // a live-mode edit: the last processes change, the run resumes from a checkpoint
+    benchmarks.push_back({ "SRTF 20k incremental edit", [&singleWorkload](){
+        SchedulingEngine session;
+        session.simulate(singleWorkload, "SRTF", 2);
+        std::vector<Process> edited = singleWorkload;
+        for (std::size_t i = edited.size() - 20; i < edited.size(); ++i){ edited[i].burstTime += 1; }
+        session.simulate(edited, "SRTF", 2);
+        return session.ganttSegments().size();
+    } });
+    
+    benchmarks.push_back({ "archive write+read RR 20k", [&singleWorkload](){
+        std::stringstream archive;
+        SchedulingEngine writer;
+        writeSchedule(archive, writer, singleWorkload, "RR", 2.0);
+        ScheduleArchive contents;
+        std::size_t segments = 0;
+        readSchedule(archive, contents, [&segments](const GanttSegment &){ ++segments; });
+        return segments;
+    } });
+    benchmarks.push_back({ "index 100k queries", [&engine, &singleWorkload](){
+        engine.simulate(singleWorkload, "RR", 2);
+        ScheduleIndex index(engine.ganttSegments());
+        double end = engine.ganttSegments().back().endTime, busy = 0;
+        std::size_t running = 0;
+        for (int i = 0; i < 100000; ++i){
+            double from = end * i / 100000;
+            busy    += index.busyTime(from, from + 50);
+            running += (index.runningAt(from) >= 0);
+        }
+        return  (busy > 0) ? running : 0;
+    } });
+    
+    WorkloadDistribution small;
+    small.processCount = 200;
+    benchmarks.push_back({ "monte carlo 500 x 200 SRTF", [&small](){
+        MonteCarloConfig config;
+        config.replications = 500;
+        simulateMonteCarlo(small, "SRTF", 2, config);
+        return config.replications;
+    } });
+    std::vector<std::vector<Process>> shards(64);
+    WorkloadDistribution shard;
+    shard.processCount = 2000;
+    for (std::size_t i = 0; i < shards.size(); ++i){ shards[i] = sampleWorkload(shard, 100 + i); }
+    benchmarks.push_back({ "batch 64 x 2k RR", [&shards](){
+        return simulateBatch(shards, "RR", 2).total.processCount;
+    } });
+    
+    WorkloadDistribution jobs;
+    jobs.processCount = 25;
+    const std::vector<Process> optimalWorkload = sampleWorkload(jobs, 5);
+    benchmarks.push_back({ "optimal 25 jobs", [&optimalWorkload](){
+        OptimalConfig config;
+        config.nodeLimit = 200000;
+        return static_cast<std::size_t>(solveOptimal(optimalWorkload, config).nodes);
+    } });
+    
+    std::cout << std::left << std::setw(30) << "benchmark" << std::right << std::setw(12) << "best ms" << std::setw(12)
+              << "median ms" << std::setw(16) << "items/s" << "\n" << std::fixed;
+    for (const auto &benchmark : benchmarks){
+        std::vector<double> milliseconds;
+        std::size_t items = 0;
+        for (int r = 0; r < repetitions; ++r){
+            auto start = std::chrono::steady_clock::now();
+            items = benchmark.run();
+            milliseconds.push_back(std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count());
+        }
+        std::sort(milliseconds.begin(), milliseconds.end());
+        double best = milliseconds.front(), median = milliseconds[milliseconds.size() / 2];
+        std::cout << std::left << std::setw(30) << benchmark.name << std::right << std::setprecision(2) << std::setw(12) << best
+                  << std::setw(12) << median << std::setprecision(0) << std::setw(16) << ((best > 0) ? items * 1000 / best : 0)
+                  << "\n";
+    }
+    return 0;
+}
@@ -0,0 +1,135 @@
+#include "Results.hpp"
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <cstdlib>
+#include <cctype>
+
+
+// scheduler_cli: simulates a workload without the web app
+// the workload is csv: process_id,priority,arrival,burst, optionally followed by burst2,io (IO) & period,deadline (EDF & RMS),
+// a process id of 0 is its line no.; lines that don't start with a number (e.g. a header) are skipped
+// prints the statistics as csv (or the gantt segments with --gantt) & the summary on stderr
+
+static const char *usage =
+    "usage: scheduler_cli [options] [workload.csv]   (default: stdin)\n"
+    "  -a ALGORITHM   FCFS (default), SJF, PR, RR, SRTF, PRP, IO, MLFQ, CFS, STRIDE, LOTTERY, EDF or RMS\n"
+    "  -q QUANTUM     time quantum (default 2)\n"
+    "  -c CPUS        cpus of the multi-cpu algorithms, with a shared run queue (default 1)\n"
+    "  -s COST        context switch cost (default 0)\n"
+    "  --gantt        print the gantt segments instead of the statistics\n"
+    "  --archive FILE also write the schedule archive (see ScheduleFormat.hpp)\n";
+
+
+// one process per line, false (& the line no.) on a malformed line
+static bool readWorkload(std::istream &in, std::vector<Process> &processes, std::size_t &lineNumber){
+    
+    std::string line, field;
+    for (lineNumber = 1; std::getline(in, line); ++lineNumber){
+        if (line.empty()  or  not (std::isdigit(static_cast<unsigned char>(line[0]))  or  line[0] == '-'))  continue;
+        
+        double values[8] = { 0, 0, 0, 0, 0, 0, 0, 0 }; // id, priority, arrival, burst, burst2, io, period, deadline
+        std::istringstream fields(line);
+        for (int column = 0; column < 8  and  std::getline(fields, field, ','); ++column){
+            char *end;
+            values[column] = std::strtod(field.c_str(), &end);
+            if (end == field.c_str())  return false;
+        }
+        Process process;
+        process.id          = (values[0] > 0) ? static_cast<int>(values[0]) : static_cast<int>(lineNumber);
+        process.priority    = static_cast<int>(values[1]);
+        process.arrivalTime = values[2];
+        process.burstTime   = values[3];
+        process.burstTime2  = values[4];
+        process.ioTime      = values[5];
+        process.period      = values[6];
+        process.deadline    = values[7];
+        if (not (process.arrivalTime >= 0)  or  not (process.burstTime > 0)  or  not (process.burstTime2 >= 0)  or
+            not (process.ioTime >= 0)  or  not (process.period >= 0)  or  not (process.deadline >= 0))  return false;
+        processes.push_back(process);
+    }
+    return true;
+}
+
+
+int main(int argc, char *argv[]){
+    
+    std::string algorithm = "FCFS", inputPath, archivePath;
+    double quantum = 2;
+    bool printGantt = false;
+    CpuConfig cpuConfig;
+    SwitchCostConfig switchCosts;
+    
+    for (int i = 1; i < argc; ++i){
+        std::string option = argv[i];
+        bool hasValue = (i + 1 < argc);
+        if (option == "-a"  and  hasValue)  algorithm = argv[++i];
+        else if (option == "-q"  and  hasValue)  quantum = std::atof(argv[++i]);
+        else if (option == "-c"  and  hasValue)  cpuConfig.cores = std::atoi(argv[++i]);
+        else if (option == "-s"  and  hasValue)  switchCosts.contextSwitch = std::atof(argv[++i]);
+        else if (option == "--archive"  and  hasValue)  archivePath = argv[++i];
+        else if (option == "--gantt")  printGantt = true;
+        else if (option[0] != '-'  and  inputPath.empty())  inputPath = option;
+        else { std::cerr << usage;  return 2; }
+    }
+    
+    // same rules as the ui
+    const char *invalid = nullptr;
+    if (not SchedulingEngine::isKnown(algorithm))  invalid = "unknown algorithm";
+    else if ((algorithm == "RR"  or  algorithm == "MLFQ"  or  SchedulingEngine::isProportionalShare(algorithm))  and
+             not (quantum > 0))  invalid = "quantum must be greater than 0";
+    else if (cpuConfig.cores < 1  or  cpuConfig.cores > 4096)  invalid = "cpus must be 1 - 4096";
+    else if (not (switchCosts.contextSwitch >= 0))  invalid = "switch cost cannot be negative";
+    if (invalid){ std::cerr << "scheduler_cli: " << invalid << "\n" << usage;  return 2; }
+    
+    std::vector<Process> processes;
+    std::size_t lineNumber;
+    std::ifstream file;
+    if (not inputPath.empty()){
+        file.open(inputPath);
+        if (not file){ std::cerr << "scheduler_cli: cannot open " << inputPath << "\n";  return 1; }
+    }
+    if (not readWorkload((file.is_open()) ? file : std::cin, processes, lineNumber)){
+        std::cerr << "scheduler_cli: bad process on line " << lineNumber << "\n";
+        return 1;
+    }
+    
+    SchedulingEngine engine;
+    engine.setCheckpointing(false);
+    engine.setSwitchCostConfig(switchCosts);
+    if (not archivePath.empty()){
+        std::ofstream archive(archivePath, std::ios::binary);
+        if (not archive  or  not writeSchedule(archive, engine, processes, algorithm, quantum, cpuConfig)  or  not archive.flush()){
+            std::cerr << "scheduler_cli: cannot write " << archivePath << "\n";
+            return 1;
+        }
+    }
+    // the archive is streamed, the engine keeps no segments meanwhile
+    if (archivePath.empty()  or  printGantt)  engine.simulate(processes, algorithm, quantum, cpuConfig);
+    
+    // the csv of the downloads (see ScheduleExportResource)
+    std::cout.precision(15);
+    if (printGantt){
+        std::cout << "process_id,start,end,cpu,overhead\n";
+        for (const auto &segment : engine.ganttSegments()){
+            std::cout << segment.processId << ',' << segment.startTime << ',' << segment.endTime << ',' << segment.core << ','
+                      << segment.overhead << '\n';
+        }
+    } else {
+        std::cout << "process_id,priority,arrival,burst,burst2,io,completion,turnaround,waiting,response\n";
+        for (const auto &process : engine.processes()){
+            std::cout << process.id << ',' << process.priority << ',' << process.arrivalTime << ',' << process.burstTime << ','
+                      << process.burstTime2 << ',' << process.ioTime << ',' << process.completionTime << ','
+                      << process.turnaroundTime << ',' << process.waitingTime << ',' << process.responseTime << '\n';
+        }
+    }
+    
+    ScheduleStatistics statistics;
+    for (const auto &process : engine.processes()){ statistics.add(process, algorithm == "IO"); }
+    int cores = (SchedulingEngine::supportsMultiCpu(algorithm)) ? cpuConfig.cores : 1;
+    std::cerr << algorithm << ": " << statistics.processCount << " processes, average waiting "
+              << statistics.averageWaitingTime() << ", turnaround " << statistics.averageTurnaroundTime() << ", response "
+              << statistics.averageResponseTime() << ", throughput " << statistics.throughput() << ", cpu utilization "
+              << 100 * statistics.cpuUtilization(cores) << " %\n";
+    return 0;
+}
@@ -1,20 +1,49 @@
 
 #include "Classes.hpp"
 #include <memory>
+#include <iostream>
 
 
 ProcessSchedulingCalculator::ProcessSchedulingCalculator(const Wt::WEnvironment &env)
-    : WApplication(env), currentProcessCount_(0), selectedAlgorithm_("FCFS"), timeQuantum_(2.0){
+    : WApplication(env), currentProcessCount_(0), selectedAlgorithm_("FCFS"), timeQuantum_(2.0), resultsVersion_(0), ganttClientSegments_(0),
+      liveGeneration_(std::make_shared<std::atomic<unsigned>>(0)), optimalSearches_(0){
+    
+    ServerMetrics::instance().count(ServerMetrics::SESSIONS_STARTED);
     
     // Create main interface
     createInterface();
 }
 
+ProcessSchedulingCalculator::~ProcessSchedulingCalculator(){
+    ServerMetrics::instance().count(ServerMetrics::SESSIONS_ENDED);
+}
+
 // Main application entry point
 std::unique_ptr<Wt::WApplication> createApplication(const Wt::WEnvironment &env) {
     return std::make_unique<ProcessSchedulingCalculator>(env);
 }
 
+// the server of Wt::WRun(), with the /metrics & /api/schedule endpoints added as static resources
 int main(int argc, char *argv[]){
-    return Wt::WRun(argc, argv, &createApplication);
+    try {
+        Wt::WServer server(argc, argv, WTHTTP_CONFIGURATION);
+        server.addEntryPoint(Wt::EntryPointType::Application, &createApplication);
+        server.addResource(std::make_shared<MetricsResource>(), "/metrics");
+        server.addResource(std::make_shared<ScheduleApiResource>(), "/api/schedule");
+        
+        if (server.start()){
+            Wt::WServer::waitForShutdown();
+            server.stop();
+            BackgroundPool::instance().stop(); // the running calculations post to the server
+        }
+    }
+    catch (const Wt::WServerException &e){
+        std::cerr << e.what() << std::endl;
+        return 1;
+    }
+    catch (const std::exception &e){
+        std::cerr << "exception: " << e.what() << std::endl;
+        return 1;
+    }
+    return 0;
 }
\ No newline at end of file
@@ -0,0 +1,112 @@
+// client side gantt chart of the scheduler (see GanttDataResource in Exports.hpp)
+// a chart keeps the segments of the last results, fetches only the ones from the first changed segment on,
+// and draws one table per cpu with the .gantt-process / .gantt-overhead / .gantt-time cells of setupGanttChart()
+var SchedulerGantt = (function(){
+
+    var palette = [ "#FF6B6B", "#4ECDC4", "#45B7D1", "#96CEB4", "#FFEAA7",
+                    "#DDA0DD", "#98D8C8", "#F7DC6F", "#BB8FCE", "#85C1E9",
+                    "#F8C471", "#82E0AA", "#F1948A", "#85929E", "#D7BDE2" ];
+
+    function color(processId){
+        var n = palette.length;
+        return palette[((processId - 1) % n + n) % n];
+    }
+    function label(time){ // like the default formatting of a double on the server (6 significant digits)
+        return String(parseFloat(time.toPrecision(6)));
+    }
+    function state(chart){
+        if (!chart.ganttState)  chart.ganttState = { segments: null, queue: [], busy: false, generation: 0 };
+        return chart.ganttState;
+    }
+
+    // segments [from, count) of the answer replace the ones the chart has from there on
+    function merge(segments, buffer){
+        var view = new DataView(buffer), count = view.getUint32(0, true), from = view.getUint32(4, true), n = count - from;
+        var next = { count: count, starts: new Float64Array(count), ends: new Float64Array(count),
+                     ids: new Int32Array(count), cores: new Uint16Array(count), flags: new Uint8Array(count) };
+        var kept = Math.min(from, segments.count);
+        if (kept > 0){
+            next.starts.set(segments.starts.subarray(0, kept));
+            next.ends.set(segments.ends.subarray(0, kept));
+            next.ids.set(segments.ids.subarray(0, kept));
+            next.cores.set(segments.cores.subarray(0, kept));
+            next.flags.set(segments.flags.subarray(0, kept));
+        }
+        next.starts.set(new Float64Array(buffer, 8, n), from);
+        next.ends.set(new Float64Array(buffer, 8 + 8 * n, n), from);
+        next.ids.set(new Int32Array(buffer, 8 + 16 * n, n), from);
+        next.cores.set(new Uint16Array(buffer, 8 + 20 * n, n), from);
+        next.flags.set(new Uint8Array(buffer, 8 + 22 * n, n), from);
+        return next;
+    }
+
+    function draw(chart, segments){
+        var lanes = [], i, core;
+        for (i = 0; i < segments.count; ++i){
+            core = segments.cores[i];
+            while (lanes.length <= core)  lanes.push([]);
+            lanes[core].push(i);
+        }
+        var html = ["<div style='overflow-x: auto; margin: 30px 0; font-family: Arial, sans-serif;'>"];
+        for (core = 0; core < lanes.length; ++core){
+            var lane = lanes[core], processRow = [], timeRow = [];
+            if (lane.length === 0)  continue; // cpu never used
+            if (lanes.length > 1)  html.push("<h6 class='mt-2 mb-1'> CPU " + core + " </h6>");
+
+            for (var k = 0; k < lane.length; ++k){
+                i = lane[k];
+                var id = segments.ids[i], width = Math.floor((segments.ends[i] - segments.starts[i]) * 40);
+                if (segments.flags[i] & 1){ // switching to the process
+                    processRow.push("<td class='gantt-process gantt-overhead' style='width: " + width + "px;' title='switch to P" +
+                                    id + "'></td>");
+                } else {
+                    processRow.push("<td class='gantt-process' style='width: " + width + "px; background: " + color(id) +
+                                    ";'>P" + id + "</td>");
+                }
+                timeRow.push("<td class='gantt-time'><div class='d-flex justify-content-between text-dark fs-6'><span>" +
+                             label(segments.starts[i]) + "</span><span> - </span><span>" + label(segments.ends[i]) +
+                             "</span></div></td>");
+            }
+            html.push("<table style='border-collapse: separate; border-spacing: 0; width: auto;'><tr>", processRow.join(""),
+                      "</tr><tr>", timeRow.join(""), "</tr></table>");
+        }
+        html.push("</div>");
+        chart.innerHTML = html.join("");
+    }
+
+    // the updates of a chart are fetched one after the other, as each one builds on the segments of the previous one;
+    // the chart is drawn once the queue is empty
+    function next(chart){
+        var s = state(chart);
+        if (s.busy  ||  s.queue.length === 0)  return;
+
+        var update = s.queue.shift(), request = new XMLHttpRequest();
+        s.busy = true;
+        request.open("GET", update.url + ((update.url.indexOf("?") < 0) ? "?" : "&") + "from=" + update.from);
+        request.responseType = "arraybuffer";
+        request.onloadend = function(){
+            s.busy = false;
+            if (update.generation === s.generation  &&  request.status === 200  &&  request.response){
+                s.segments = merge(s.segments || { count: 0 }, request.response);
+                if (s.queue.length === 0)  draw(chart, s.segments);
+            }
+            next(chart);
+        };
+        request.send();
+    }
+
+    return {
+        update: function(chart, url, from){
+            var s = state(chart);
+            s.queue.push({ url: url, from: from, generation: s.generation });
+            next(chart);
+        },
+        clear: function(chart){
+            var s = state(chart);
+            ++s.generation; // answers still on their way are dropped
+            s.queue = [];
+            s.segments = null;
+            chart.innerHTML = "";
+        }
+    };
+})();
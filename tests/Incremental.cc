@@ -0,0 +1,105 @@
+#include "Testing.hpp"
+#include "Results.hpp"
+#include <random>
+
+
+static std::vector<Process> randomWorkload(std::mt19937 &random, const std::size_t &count, const int &arrivals = 200){
+    std::vector<Process> processes(count);
+    for (std::size_t i = 0; i < count; ++i){
+        processes[i].id          = i + 1;
+        processes[i].priority    = 1 + random() % 10;
+        processes[i].arrivalTime = random() % arrivals;
+        processes[i].burstTime   = 1 + random() % 12;
+        processes[i].burstTime2  = random() % 4;
+        processes[i].ioTime      = random() % 6;
+    }
+    return processes;
+}
+
+static bool sameResults(const SchedulingEngine &e1, const SchedulingEngine &e2){
+    const auto &s1 = e1.ganttSegments(), &s2 = e2.ganttSegments();
+    if (s1.size() != s2.size()  or  e1.processes().size() != e2.processes().size())  return false;
+    for (std::size_t i = 0; i < s1.size(); ++i){
+        if (s1[i].processId != s2[i].processId  or  s1[i].startTime != s2[i].startTime  or  s1[i].endTime != s2[i].endTime  or
+            s1[i].core != s2[i].core  or  s1[i].overhead != s2[i].overhead)  return false;
+    }
+    for (std::size_t i = 0; i < e1.processes().size(); ++i){
+        const Process &p1 = e1.processes()[i], &p2 = e2.processes()[i];
+        if (p1.completionTime != p2.completionTime  or  p1.waitingTime != p2.waitingTime  or
+            p1.responseTime != p2.responseTime)  return false;
+    }
+    return true;
+}
+
+
+// a run detached to another engine & attached back gives the results of a run of the engine itself, and the
+// engine resumes from the attached checkpoints afterwards
+TEST(Incremental, detachedRunsMatchSimulate){
+    std::mt19937 random(27);
+    for (int round = 0; round < 60; ++round){
+        for (const char *algorithm : { "FCFS", "SJF", "PR", "RR", "SRTF", "PRP", "IO", "MLFQ", "CFS" }){
+            std::vector<Process> processes = randomWorkload(random, 5 + random() % 200);
+            SchedulingEngine session, reference;     // reference: runs every edit itself
+            session.simulate(processes, algorithm, 2);
+            reference.simulate(processes, algorithm, 2);
+            
+            for (int edit = 0; edit < 3; ++edit){
+                // a few late processes change, or none
+                for (int k = random() % 3; k > 0; --k){
+                    Process &process = processes[random() % processes.size()];
+                    process.burstTime   = 1 + random() % 12;
+                    process.arrivalTime = 100 + random() % 100;
+                }
+                SchedulingEngine detached = session.detach(processes, algorithm, 2);
+                std::size_t firstChanged = detached.simulate(processes, algorithm, 2);
+                std::size_t handedBack = detached.ganttSegments().size(); // only the segments from the first changed one on
+                session.attach(std::move(detached));
+                CHECK(session.ganttSegments().size() == ((session.reusedResults()) ? firstChanged : 0) + handedBack);
+                
+                SchedulingEngine fresh;
+                fresh.simulate(processes, algorithm, 2);
+                CHECK(sameResults(session, fresh));
+                CHECK(reference.simulate(processes, algorithm, 2) == firstChanged);
+                CHECK(reference.reusedResults() == session.reusedResults());
+                CHECK(sameResults(session, reference));
+            }
+            // a run of the attached engine itself resumes from its checkpoints
+            processes.back().burstTime += 1;
+            session.simulate(processes, algorithm, 2);
+            SchedulingEngine fresh;
+            fresh.simulate(processes, algorithm, 2);
+            CHECK(sameResults(session, fresh));
+        }
+    }
+}
+
+
+// an unchanged workload hands over no segments at all, a late edit only the segments after its checkpoint
+TEST(Incremental, detachHandsOverTheChangedPart){
+    std::mt19937 random(270);
+    std::vector<Process> processes = randomWorkload(random, 2000, 2000 * 8); // about 80 % load
+    SchedulingEngine session;
+    session.simulate(processes, "SRTF", 2);
+    std::size_t segments = session.ganttSegments().size();
+    
+    SchedulingEngine unchanged = session.detach(processes, "SRTF", 2);
+    CHECK(unchanged.simulate(processes, "SRTF", 2) == segments);
+    CHECK(unchanged.reusedResults()  and  unchanged.ganttSegments().empty());
+    session.attach(std::move(unchanged));
+    CHECK(session.ganttSegments().size() == segments);
+    
+    std::size_t last = 0;
+    for (std::size_t i = 0; i < processes.size(); ++i){
+        if (processes[i].arrivalTime > processes[last].arrivalTime)  last = i;
+    }
+    processes[last].burstTime += 3;
+    SchedulingEngine edited = session.detach(processes, "SRTF", 2);
+    std::size_t firstChanged = edited.simulate(processes, "SRTF", 2);
+    CHECK(edited.reusedResults()  and  firstChanged > segments / 2);
+    CHECK(edited.ganttSegments().size() < segments / 2);
+    session.attach(std::move(edited));
+    
+    SchedulingEngine fresh;
+    fresh.simulate(processes, "SRTF", 2);
+    CHECK(sameResults(session, fresh));
+}
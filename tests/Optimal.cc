@@ -0,0 +1,124 @@
+#include "Testing.hpp"
+#include "Results.hpp"
+#include <random>
+#include <functional>
+
+
+// best objective of every order of the bursts (the second burst of a job after its first & its i/o), each burst
+// starting as soon as the cpu & the job are ready
+static double enumerateAll(const std::vector<Process> &processes, const OptimalConfig::Objective objective, const bool secondBursts){
+    
+    int n = processes.size(), bursts = 0;
+    std::vector<int> stage(n, 0);
+    std::vector<double> ready(n), completion(n);
+    for (int j = 0; j < n; ++j){
+        ready[j] = processes[j].arrivalTime;
+        bursts  += (secondBursts  and  processes[j].burstTime2 > 0) ? 2 : 1;
+    }
+    double best = std::numeric_limits<double>::infinity();
+    std::function<void(double, int)> next = [&](const double time, const int left){
+        if (left == 0){
+            std::vector<Process> done = processes;
+            for (int j = 0; j < n; ++j){ done[j].completionTime = completion[j]; }
+            best = std::min(best, scheduleObjective(done, objective));
+            return;
+        }
+        for (int j = 0; j < n; ++j){
+            if (stage[j] == ((secondBursts  and  processes[j].burstTime2 > 0) ? 2 : 1))  continue;
+            double start = std::max(time, ready[j]), end = start + ((stage[j]) ? processes[j].burstTime2 : processes[j].burstTime);
+            double readyBefore = ready[j], completionBefore = completion[j];
+            ready[j] = end + ((stage[j]) ? 0 : processes[j].ioTime);
+            completion[j] = end;
+            ++stage[j];
+            next(end, left - 1);
+            --stage[j];
+            ready[j] = readyBefore;
+            completion[j] = completionBefore;
+        }
+    };
+    next(0, bursts);
+    return best;
+}
+
+
+TEST(Optimal, matchesFullEnumeration){
+    std::mt19937 random(47);
+    for (int round = 0; round < 400; ++round){
+        bool secondBursts = random() % 2;
+        std::vector<Process> processes(1 + random() % ((secondBursts) ? 4 : 6));
+        for (std::size_t i = 0; i < processes.size(); ++i){
+            Process &process = processes[i];
+            process.id          = i + 1;
+            process.arrivalTime = random() % 12;
+            process.burstTime   = 1 + random() % 6;
+            process.priority    = 1 + random() % 5;
+            if (secondBursts){
+                process.ioTime     = random() % 5;
+                process.burstTime2 = (random() % 3) ? 1 + random() % 4 : 0;
+            }
+        }
+        for (auto objective : { OptimalConfig::TOTAL_COMPLETION, OptimalConfig::WEIGHTED_COMPLETION, OptimalConfig::MAKESPAN }){
+            OptimalConfig config;
+            config.objective    = objective;
+            config.secondBursts = secondBursts;
+            config.threadCount  = 1 + round % 4;
+            OptimalSchedule optimum = solveOptimal(processes, config);
+            
+            CHECK(optimum.optimal);
+            CHECK(optimum.lowerBound == optimum.value);
+            CHECK(std::fabs(optimum.value - enumerateAll(processes, objective, secondBursts)) < 1e-9);
+            
+            // the schedule has the value, every burst of a job in order & none overlap
+            std::vector<Process> done = processes;
+            double cpuFree = 0;
+            for (const auto &segment : optimum.segments){
+                CHECK(segment.startTime >= cpuFree);
+                cpuFree = segment.endTime;
+                Process &process = done[segment.processId - 1];
+                CHECK(segment.startTime >= process.arrivalTime);
+                process.completionTime = segment.endTime;
+            }
+            CHECK(std::fabs(scheduleObjective(done, objective) - optimum.value) < 1e-9);
+        }
+    }
+}
+
+
+// the subtrees are split among the threads: any thread count proves the same optimum (of equal schedules, the one
+// found first is kept), & the node limit still holds
+TEST(Optimal, sameOptimumOnAnyThreads){
+    std::mt19937 random(4700);
+    for (int round = 0; round < 20; ++round){
+        std::vector<Process> processes(8 + random() % 6);
+        for (std::size_t i = 0; i < processes.size(); ++i){
+            processes[i].id          = i + 1;
+            processes[i].arrivalTime = random() % 30;
+            processes[i].burstTime   = 1 + random() % 9;
+            processes[i].priority    = 1 + random() % 10;
+        }
+        OptimalConfig config;
+        config.objective   = OptimalConfig::WEIGHTED_COMPLETION;
+        config.threadCount = 1;
+        OptimalSchedule single = solveOptimal(processes, config);
+        config.threadCount = 4;
+        OptimalSchedule parallel = solveOptimal(processes, config);
+        
+        CHECK(single.optimal  and  parallel.optimal);
+        CHECK(single.value == parallel.value);
+        CHECK(parallel.segments.size() == processes.size());
+    }
+    
+    std::vector<Process> processes(30);
+    for (std::size_t i = 0; i < processes.size(); ++i){
+        processes[i].id          = i + 1;
+        processes[i].arrivalTime = random() % 60;
+        processes[i].burstTime   = 1 + random() % 9;
+    }
+    OptimalConfig config;
+    config.nodeLimit   = 5000;
+    config.threadCount = 4;
+    OptimalSchedule limited = solveOptimal(processes, config);
+    CHECK(limited.nodes < 2 * config.nodeLimit);
+    CHECK(limited.segments.size() == processes.size());
+    CHECK(limited.lowerBound <= limited.value);
+}
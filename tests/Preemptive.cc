@@ -0,0 +1,79 @@
+#include "Testing.hpp"
+#include "Results.hpp"
+#include <random>
+#include <algorithm>
+
+
+// SRTF & PRP against a reference that steps the clock by half units (all times here are on that grid):
+// every step the best ready process runs, the running one keeps the cpu unless another is strictly better,
+// ties go to the earlier arrival, then to the input order (the priorities below are distinct, PRP has no ties)
+static std::vector<double> referenceCompletions(const std::vector<Process> &processes, const bool byPriority, std::size_t &dispatches){
+    
+    int n = processes.size(), running = -1, done = 0;
+    std::vector<double> remaining(n), completion(n, -1);
+    for (int i = 0; i < n; ++i){ remaining[i] = processes[i].burstTime; }
+    
+    // smaller runs first
+    auto key = [&](const int i){ return  (byPriority) ? -static_cast<double>(processes[i].priority) : remaining[i]; };
+    dispatches = 0;
+    for (double time = 0; done < n; time += 0.5){
+        int best = -1;
+        for (int i = 0; i < n; ++i){
+            if (processes[i].arrivalTime > time  or  remaining[i] <= 0)  continue;
+            if (best < 0  or  key(i) < key(best)  or  (key(i) == key(best)  and  processes[i].arrivalTime < processes[best].arrivalTime)){
+                best = i;
+            }
+        }
+        if (running >= 0  and  best >= 0  and  not (key(best) < key(running)))  best = running;
+        if (best != running  and  best >= 0)  ++dispatches;
+        running = best;
+        if (running < 0)  continue;
+        
+        remaining[running] -= 0.5;
+        if (remaining[running] <= 0){
+            completion[running] = time + 0.5;
+            ++done;
+            running = -1;
+        }
+    }
+    return completion;
+}
+
+
+TEST(Preemptive, matchesReference){
+    std::mt19937 random(28);
+    for (int round = 0; round < 1000; ++round){
+        std::vector<Process> processes(1 + random() % 40);
+        std::vector<int> priorities(processes.size());
+        for (std::size_t i = 0; i < processes.size(); ++i){ priorities[i] = i + 1; }
+        std::shuffle(priorities.begin(), priorities.end(), random);
+        for (std::size_t i = 0; i < processes.size(); ++i){
+            processes[i].id          = i + 1;
+            processes[i].arrivalTime = (random() % 40) * 0.5;
+            processes[i].burstTime   = 1 + (random() % 20) * 0.5;
+            processes[i].priority    = priorities[i];
+        }
+        for (const char *algorithm : { "SRTF", "PRP" }){
+            SchedulingEngine engine;
+            engine.simulate(processes, algorithm, 1);
+            std::size_t dispatches;
+            std::vector<double> completion = referenceCompletions(processes, algorithm[0] == 'P', dispatches);
+            
+            for (std::size_t i = 0; i < processes.size(); ++i){
+                const Process &process = engine.processes()[i];
+                CHECK(process.completionTime == completion[i]);
+                CHECK(process.turnaroundTime == process.completionTime - process.arrivalTime);
+                CHECK(process.waitingTime == process.turnaroundTime - process.burstTime);
+            }
+            // SRTF makes one segment per dispatch: a process that keeps the cpu is never split (PRP still cuts
+            // the running one at every arrival)
+            const auto &segments = engine.ganttSegments();
+            CHECK(algorithm[0] == 'P'  or  segments.size() == dispatches);
+            for (std::size_t k = 1; k < segments.size(); ++k){
+                CHECK(segments[k].startTime >= segments[k - 1].endTime);
+                CHECK(algorithm[0] == 'P'  or  not (segments[k].processId == segments[k - 1].processId  and
+                                                    segments[k].startTime == segments[k - 1].endTime));
+            }
+        }
+    }
+}
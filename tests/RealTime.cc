@@ -0,0 +1,117 @@
+#include "Testing.hpp"
+#include "Results.hpp"
+#include <random>
+
+
+// deadline misses of EDF / RMS by a step-by-step simulation: every time unit the best released job runs,
+// by (deadline or period, release, arrival rank) as in runRealTime(); integer times only
+static std::uint64_t referenceMisses(const std::vector<Process> &tasks, const bool edf, const int horizon, std::uint64_t &jobs){
+    
+    struct Job { double key, release, deadline, remaining; int rank; };
+    std::vector<int> rank(tasks.size());
+    for (std::size_t i = 0; i < tasks.size(); ++i){
+        rank[i] = 0;
+        for (std::size_t j = 0; j < tasks.size(); ++j){
+            if (tasks[j].arrivalTime < tasks[i].arrivalTime  or  (tasks[j].arrivalTime == tasks[i].arrivalTime  and  j < i))  ++rank[i];
+        }
+    }
+    std::vector<Job> ready;
+    std::uint64_t misses = 0;
+    jobs = 0;
+    for (int t = 0; ; ++t){
+        bool releasesLeft = false;
+        for (std::size_t i = 0; i < tasks.size(); ++i){
+            const Process &task = tasks[i];
+            int arrival = task.arrivalTime, period = task.period;
+            bool due = (t == arrival)  or  (period > 0  and  t > arrival  and  t < horizon  and  (t - arrival) % period == 0);
+            if (due){
+                double deadline = (task.deadline > 0) ? t + task.deadline : (period > 0) ? t + period : 1e300;
+                ready.push_back({ (edf) ? deadline : (period > 0) ? period : deadline - t, double(t), deadline, task.burstTime, rank[i] });
+                ++jobs;
+            }
+            releasesLeft = releasesLeft  or  t < arrival  or  (period > 0  and  t + 1 < horizon);
+        }
+        if (ready.empty()){ if (releasesLeft)  continue;  break; }
+        
+        auto best = ready.begin();
+        for (auto job = ready.begin(); job != ready.end(); ++job){
+            if (job->key != best->key ? job->key < best->key : job->release != best->release ? job->release < best->release :
+                job->rank < best->rank)  best = job;
+        }
+        if (--best->remaining <= 0){
+            if (t + 1 > best->deadline)  ++misses;
+            ready.erase(best);
+        }
+    }
+    return misses;
+}
+
+
+TEST(RealTime, knownMissCounts){
+    // C = (2, 4), T = (5, 7): U = 0.97, EDF meets every deadline, RMS misses the first one of the second task
+    std::vector<Process> tasks(2);
+    tasks[0].id = 1;  tasks[0].burstTime = 2;  tasks[0].period = 5;
+    tasks[1].id = 2;  tasks[1].burstTime = 4;  tasks[1].period = 7;
+    
+    SchedulingEngine engine;
+    engine.simulate(tasks, "EDF", 1);
+    CHECK(engine.deadlineReport().jobs == 7 + 5);      // one hyperperiod (35)
+    CHECK(engine.deadlineReport().deadlineMisses == 0);
+    
+    engine.simulate(tasks, "RMS", 1);
+    CHECK(engine.deadlineReport().deadlineMisses > 0);
+    CHECK(engine.deadlineReport().processMisses[0] == 0);
+    CHECK(engine.deadlineReport().processMisses[1] == engine.deadlineReport().deadlineMisses);
+}
+
+
+TEST(RealTime, missesMatchReference){
+    std::mt19937 random(43);
+    for (int round = 0; round < 300; ++round){
+        std::vector<Process> tasks(1 + random() % 5);
+        for (std::size_t i = 0; i < tasks.size(); ++i){
+            tasks[i].id          = i + 1;
+            tasks[i].arrivalTime = random() % 6;
+            tasks[i].period      = (random() % 4) ? 3 + random() % 10 : 0;
+            tasks[i].burstTime   = 1 + random() % 4;
+            tasks[i].deadline    = (random() % 3 == 0) ? 2 + random() % 8 : 0;
+        }
+        int horizon = 40 + random() % 40;
+        RealTimeConfig config;
+        config.horizon = horizon;
+        for (bool edf : { true, false }){
+            SchedulingEngine engine;
+            engine.setRealTimeConfig(config);
+            engine.simulate(tasks, (edf) ? "EDF" : "RMS", 1);
+            std::uint64_t jobs, misses = referenceMisses(tasks, edf, horizon, jobs);
+            CHECK(engine.deadlineReport().jobs == jobs);
+            CHECK(engine.deadlineReport().deadlineMisses == misses);
+        }
+    }
+}
+
+
+TEST(RealTime, defaultHorizonIsCapped){
+    // co-prime periods: the hyperperiod is about 6.7e9, the default horizon stops at 100 of the longest period
+    std::vector<Process> tasks;
+    for (int period : { 7, 11, 13, 17, 19, 23, 29, 31 }){
+        Process task;
+        task.id        = tasks.size() + 1;
+        task.burstTime = 0.5;
+        task.period    = period;
+        tasks.push_back(task);
+    }
+    RealTimeConfig config;
+    CHECK(config.releaseHorizon(tasks) == 100 * 31);
+    
+    SchedulingEngine engine;
+    engine.simulate(tasks, "EDF", 1);
+    CHECK(engine.deadlineReport().jobs == config.jobCount(tasks));
+    CHECK(engine.deadlineReport().jobs < 3000);
+    CHECK(engine.deadlineReport().deadlineMisses == 0);
+    
+    // a short hyperperiod is still the default
+    tasks.resize(2);
+    tasks[1].period = 14;
+    CHECK(config.releaseHorizon(tasks) == 14);
+}
@@ -0,0 +1,118 @@
+#include "Testing.hpp"
+#include "Results.hpp"
+#include <random>
+#include <sstream>
+
+
+static std::vector<Process> randomWorkload(std::mt19937 &random){
+    std::vector<Process> processes(1 + random() % 60);
+    for (std::size_t i = 0; i < processes.size(); ++i){
+        processes[i].id          = i + 1;
+        processes[i].priority    = 1 + random() % 10;
+        processes[i].arrivalTime = (random() % 80) * 0.5;
+        processes[i].burstTime   = 0.5 + (random() % 16) * 0.5;
+        processes[i].burstTime2  = (random() % 4) * 0.5;
+        processes[i].ioTime      = (random() % 6) * 0.5;
+    }
+    return processes;
+}
+
+
+// an archive gives back the segments & the per-job statistics of the run that wrote it (times on the tick grid)
+TEST(ScheduleFormat, roundTrip){
+    std::mt19937 random(35);
+    const char *algorithms[] = { "FCFS", "SJF", "PR", "RR", "SRTF", "PRP", "IO", "MLFQ", "STRIDE" };
+    for (int round = 0; round < 60; ++round){
+        std::vector<Process> processes = randomWorkload(random);
+        for (const char *algorithm : algorithms){
+            CpuConfig cpuConfig;
+            cpuConfig.cores = (round % 3 == 0) ? 3 : 1;
+            cpuConfig.perCoreQueues = (round % 2 == 0);
+            SwitchCostConfig switchCosts;
+            switchCosts.contextSwitch = (round % 4 == 1) ? 0.25 : 0;
+            switchCosts.migration     = (round % 4 == 1) ? 0.5 : 0;
+            
+            SchedulingEngine engine, writing;
+            engine.setSwitchCostConfig(switchCosts);
+            writing.setSwitchCostConfig(switchCosts);
+            engine.simulate(processes, algorithm, 1.5, cpuConfig);
+            std::stringstream archiveBytes;
+            CHECK(writeSchedule(archiveBytes, writing, processes, algorithm, 1.5, cpuConfig) > 0);
+            CHECK(writing.ganttSegments().empty()); // streamed, not kept
+            
+            ScheduleArchive archive;
+            std::vector<GanttSegment> segments;
+            CHECK(readSchedule(archiveBytes, archive, [&segments](const GanttSegment &segment){ segments.push_back(segment); }));
+            CHECK(archive.ticksPerUnit == 1000);
+            CHECK(archive.multiCpu == (cpuConfig.cores > 1  and  SchedulingEngine::supportsMultiCpu(algorithm)));
+            CHECK(archive.overheads == switchCosts.any());
+            
+            const auto &expected = engine.ganttSegments();
+            CHECK(archive.segmentCount == expected.size()  and  segments.size() == expected.size());
+            for (std::size_t i = 0; i < std::min(segments.size(), expected.size()); ++i){
+                CHECK(segments[i].processId == expected[i].processId  and  segments[i].core == expected[i].core);
+                CHECK(segments[i].startTime == expected[i].startTime  and  segments[i].endTime == expected[i].endTime);
+                CHECK(segments[i].overhead == expected[i].overhead);
+            }
+            CHECK(archive.processes.size() == processes.size());
+            for (std::size_t i = 0; i < std::min(archive.processes.size(), processes.size()); ++i){
+                const Process &read = archive.processes[i], &run = engine.processes()[i];
+                CHECK(read.id == run.id  and  read.priority == run.priority  and  read.arrivalTime == run.arrivalTime);
+                CHECK(read.burstTime == run.burstTime  and  read.burstTime2 == run.burstTime2  and  read.ioTime == run.ioTime);
+                CHECK(read.completionTime == run.completionTime  and  read.turnaroundTime == run.turnaroundTime);
+                CHECK(read.waitingTime == run.waitingTime  and  read.responseTime == run.responseTime);
+            }
+            
+            // the statistics alone, straight from the footer
+            archiveBytes.clear();
+            archiveBytes.seekg(0);
+            ScheduleArchive statistics;
+            CHECK(readSchedule(archiveBytes, statistics));
+            CHECK(statistics.segmentCount == archive.segmentCount  and  statistics.processes.size() == processes.size());
+        }
+    }
+}
+
+
+// a tick engine writes its ticks as they are
+TEST(ScheduleFormat, tickRoundTrip){
+    std::mt19937 random(350);
+    std::vector<BasicProcess<std::int64_t>> processes = TickResolution<2>::toTicks(randomWorkload(random));
+    TickSchedulingEngine engine, writing;
+    engine.simulate(processes, "RR", 3);
+    std::stringstream archiveBytes;
+    writeSchedule(archiveBytes, writing, processes, "RR", std::int64_t(3));
+    
+    ScheduleArchive archive;
+    std::vector<GanttSegment> segments;
+    CHECK(readSchedule(archiveBytes, archive, [&segments](const GanttSegment &segment){ segments.push_back(segment); }));
+    CHECK(archive.ticksPerUnit == 1  and  segments.size() == engine.ganttSegments().size());
+    for (std::size_t i = 0; i < std::min(segments.size(), engine.ganttSegments().size()); ++i){
+        CHECK(segments[i].startTime == engine.ganttSegments()[i].startTime);
+        CHECK(segments[i].endTime == engine.ganttSegments()[i].endTime);
+    }
+}
+
+
+// a damaged or cut archive is refused
+TEST(ScheduleFormat, damagedRejected){
+    std::mt19937 random(3500);
+    std::vector<Process> processes = randomWorkload(random);
+    SchedulingEngine engine;
+    std::stringstream archiveBytes;
+    writeSchedule(archiveBytes, engine, processes, "SRTF", 1.0);
+    std::string bytes = archiveBytes.str();
+    
+    auto readable = [](const std::string &archiveBytes){
+        std::stringstream in(archiveBytes);
+        ScheduleArchive archive;
+        return  readSchedule(in, archive, [](const GanttSegment &){});
+    };
+    CHECK(readable(bytes));
+    CHECK(not readable(""));
+    CHECK(not readable(bytes.substr(0, bytes.size() - 1)));        // no footer
+    CHECK(not readable("X" + bytes.substr(1)));                     // no header
+    std::string version = bytes;
+    version[4] ^= 0x7f;
+    CHECK(not readable(version));
+}
@@ -0,0 +1,72 @@
+#include "Testing.hpp"
+#include "Results.hpp"
+#include <random>
+
+
+// every query of the index gives the answer of a scan of all the segments
+TEST(ScheduleIndex, matchesLinearScan){
+    std::mt19937 random(42);
+    for (int round = 0; round < 40; ++round){
+        int count = 50 + random() % 600;
+        std::vector<Process> processes(count);
+        for (int i = 0; i < count; ++i){
+            processes[i].id          = i + 1;
+            processes[i].arrivalTime = random() % (2 * count);
+            processes[i].burstTime   = 1 + random() % 9;
+            processes[i].priority    = 1 + random() % 5;
+        }
+        CpuConfig cpuConfig;
+        cpuConfig.cores = 1 + round % 4;
+        SwitchCostConfig switchCosts;
+        switchCosts.contextSwitch = (round % 3 == 0) ? 0.25 : 0;   // overhead segments too
+        SchedulingEngine engine;
+        engine.setSwitchCostConfig(switchCosts);
+        const char *algorithms[] = { "FCFS", "RR", "SRTF", "PRP" };
+        engine.simulate(processes, algorithms[round % 4], 2, cpuConfig);
+        
+        const auto &segments = engine.ganttSegments();
+        ScheduleIndex index(segments);
+        CHECK(index.size() == segments.size());
+        for (int query = 0; query < 200; ++query){
+            double from = static_cast<double>(random() % (3 * count)) - 5 + 0.5 * (random() % 2), to = from + random() % 50 + 0.25;
+            int core = random() % cpuConfig.cores, processId = 1 + random() % count;
+            
+            std::vector<std::size_t> inWindow, ofProcess;
+            double busy = 0;
+            long running = -1;
+            for (std::size_t i = 0; i < segments.size(); ++i){
+                const auto &segment = segments[i];
+                if (segment.endTime > from  and  segment.startTime < to){
+                    inWindow.push_back(i);
+                    busy += std::min(to, segment.endTime) - std::max(from, segment.startTime);
+                }
+                if (segment.core == core  and  segment.startTime <= from  and  segment.endTime > from)  running = i;
+                if (segment.processId == processId)  ofProcess.push_back(i);
+            }
+            
+            std::vector<std::size_t> window = index.window(from, to), process;
+            std::sort(window.begin(), window.end());
+            index.forEachOfProcess(processId, [&process](const std::size_t &position){ process.push_back(position); });
+            std::sort(process.begin(), process.end());
+            CHECK(window == inWindow);
+            CHECK(std::fabs(index.busyTime(from, to) - busy) < 1e-6);
+            CHECK(index.runningAt(from, core) == running);
+            CHECK(process == ofProcess);
+        }
+    }
+}
+
+
+// segments of a cpu out of start order (e.g. merged schedules) are sorted by the index
+TEST(ScheduleIndex, unorderedSegments){
+    std::vector<GanttSegment> segments = { GanttSegment(2, 4, 6), GanttSegment(1, 0, 2), GanttSegment(3, 1, 5, 1),
+                                           GanttSegment(1, 8, 9) };
+    ScheduleIndex index(segments);
+    CHECK(index.cpuCount() == 2);
+    CHECK(index.runningAt(5) == 0  and  index.runningAt(3) == -1  and  index.runningAt(3, 1) == 2);
+    CHECK(index.busyTime(1, 8.5) == 1 + 2 + 4 + 0.5);
+    CHECK(index.utilization(0, 10, 2) == (2 + 2 + 1 + 4) / 20.0);
+    
+    std::vector<std::size_t> window = index.window(2, 4);
+    CHECK(window.size() == 1  and  window[0] == 2);  // the ends & the starts are outside
+}
@@ -0,0 +1,182 @@
+#include "Testing.hpp"
+#include "Results.hpp"
+#include "ScheduleRequest.hpp"
+
+
+// reads a request, nullptr if it's fine, otherwise the error of the reader or of the checks
+static const char *readRequest(const std::string &document, ScheduleRequest &request, std::vector<Process> &processes){
+    std::string key, text;
+    JsonReader json(document, key);
+    if (not request.read(json, text, processes))  return json.error();
+    return request.invalid(processes);
+}
+static bool accepted(const std::string &document){
+    ScheduleRequest request;
+    std::vector<Process> processes;
+    return  readRequest(document, request, processes) == nullptr;
+}
+
+
+TEST(ScheduleRequest, jsonAccepted){
+    {
+        std::string key, document = " { \"a\" : [ 1, -2.5e1, true, false, null, \"x\\\"y\\n\", { } , [ ] ] } ";
+        JsonReader json(document, key);
+        std::vector<double> numbers;
+        std::vector<bool> booleans;
+        std::string text;
+        bool read = json.object([&](const std::string &name){
+            CHECK(name == "a");
+            int element = 0;
+            return  json.array([&](){
+                double number;
+                bool boolean;
+                switch (element++){
+                    case 0: case 1:  if (not json.number(number))  return false;  numbers.push_back(number);  return true;
+                    case 2: case 3:  if (not json.boolean(boolean))  return false;  booleans.push_back(boolean);  return true;
+                    case 5:          return json.string(text);
+                    default:         return json.skip();
+                }
+            });
+        });
+        CHECK(read  and  json.atEnd()  and  json.error() == nullptr);
+        CHECK(numbers.size() == 2  and  numbers[0] == 1  and  numbers[1] == -25);
+        CHECK(booleans.size() == 2  and  booleans[0]  and  not booleans[1]);
+        CHECK(text == "x\"y\n");
+    }
+    
+    // the members come in any order, unknown ones (of any value) are skipped, ids default to the position
+    ScheduleRequest request;
+    std::vector<Process> processes;
+    CHECK(readRequest("{\"processes\":[{\"arrival\":0,\"burst\":5},{\"processId\":7,\"arrival\":1,\"burst\":3,"
+                      "\"extra\":[1,{\"a\":null}]}],\"quantum\":0.5,\"algorithm\":\"RR\",\"mlfq\":{\"levels\":4},"
+                      "\"runQueues\":\"stealing\",\"cpus\":2,\"io\":{\"devices\":2,\"discipline\":\"shortest\"}}",
+                      request, processes) == nullptr);
+    CHECK(request.algorithm == "RR"  and  request.quantum == 0.5  and  request.cpuConfig.cores == 2);
+    CHECK(request.cpuConfig.perCoreQueues  and  request.cpuConfig.loadBalancing  and  request.cpuConfig.workStealing);
+    CHECK(request.mlfqConfig.levels == 4);
+    CHECK(request.ioConfig.disciplines.size() == 2  and  request.ioConfig.disciplines[1] == IoConfig::SHORTEST_FIRST);
+    CHECK(processes.size() == 2  and  processes[0].id == 1  and  processes[1].id == 7);
+    CHECK(processes[1].arrivalTime == 1  and  processes[1].burstTime == 3);
+    
+    CHECK(accepted("{\"algorithm\":\"FCFS\",\"processes\":[]}"));
+    CHECK(accepted("{\"algorithm\":\"RR\",\"quantum\":25e-1,\"cpus\":2.0,\"processes\":[{\"burst\":2E-1},{\"burst\":10}]}"));
+    CHECK(accepted("{\"algorithm\":\"EDF\",\"horizon\":20,\"processes\":[{\"burst\":1,\"period\":5},{\"burst\":2,\"period\":10}]}"));
+}
+
+
+TEST(ScheduleRequest, jsonRejected){
+    const char *documents[] = {
+        "",
+        "[]",
+        "{\"algorithm\":\"RR\" \"processes\":[]}",                  // no comma
+        "{\"algorithm\":\"RR\",\"processes\":[]} x",                 // trailing characters
+        "{\"algorithm\":\"RR\",\"processes\":[{\"burst\":}]}",       // no value
+        "{\"algorithm\":\"RR\",\"processes\":[{\"burst\":1},]}",     // trailing comma
+        "{\"algorithm\":\"RR,\"processes\":[]}",                     // unterminated string
+        "{\"algorithm\":\"RR\",\"cpus\":1.5,\"processes\":[]}",      // not an integer
+        "{\"algorithm\":\"RR\",\"segments\":1,\"processes\":[]}",    // not a boolean
+        "{\"algorithm\":\"RR\",\"runQueues\":\"some\",\"processes\":[]}",
+        "{\"algorithm\":\"IO\",\"io\":{\"discipline\":\"random\"},\"processes\":[]}",
+        "{\"algorithm\":\"RR\",\"processes\":[{\"burst\":1}]",       // unterminated object
+        "{\"algorithm\":\"RR\",\"quantum\":inf,\"processes\":[]}",    // not json numbers
+        "{\"algorithm\":\"RR\",\"quantum\":nan,\"processes\":[]}",
+        "{\"algorithm\":\"RR\",\"quantum\":0x1p3,\"processes\":[]}",
+        "{\"algorithm\":\"RR\",\"quantum\":+2,\"processes\":[]}",
+        "{\"algorithm\":\"RR\",\"quantum\":.5,\"processes\":[]}",
+        "{\"algorithm\":\"RR\",\"quantum\":2.,\"processes\":[]}",
+        "{\"algorithm\":\"RR\",\"quantum\":1e,\"processes\":[]}",
+        "{\"algorithm\":\"RR\",\"quantum\":1e400,\"processes\":[]}", // not finite
+        "{\"algorithm\":\"RR\",\"cpus\":1e20,\"processes\":[]}",      // outside of int
+        "{\"algorithm\":\"RR\",\"cpus\":-3e9,\"processes\":[]}",
+    };
+    for (const std::string document : documents){ // the reader keeps pointers into the document
+        std::string key, text;
+        std::vector<Process> processes;
+        ScheduleRequest request;
+        JsonReader json(document, key);
+        CHECK(not request.read(json, text, processes));
+        CHECK(json.error() != nullptr);
+    }
+}
+
+
+TEST(ScheduleRequest, limitsRejected){
+    // the rules of the ui
+    CHECK(not accepted("{\"algorithm\":\"SMP\",\"processes\":[]}"));
+    CHECK(not accepted("{\"algorithm\":\"RR\",\"quantum\":0,\"processes\":[]}"));
+    CHECK(not accepted("{\"algorithm\":\"RR\",\"cpus\":5000,\"processes\":[]}"));
+    CHECK(not accepted("{\"algorithm\":\"RR\",\"processes\":[{\"burst\":0}]}"));
+    CHECK(not accepted("{\"algorithm\":\"PR\",\"processes\":[{\"burst\":1,\"priority\":0}]}"));
+    CHECK(not accepted("{\"algorithm\":\"EDF\",\"horizon\":-1,\"processes\":[]}"));
+    
+    // co-prime periods with the default horizon are capped, a long horizon is refused
+    std::string coprime = "{\"algorithm\":\"EDF\",\"processes\":[{\"burst\":1,\"period\":7},{\"burst\":1,\"period\":11},"
+                          "{\"burst\":1,\"period\":13},{\"burst\":1,\"period\":17},{\"burst\":1,\"period\":19},"
+                          "{\"burst\":1,\"period\":23},{\"burst\":1,\"period\":29},{\"burst\":1,\"period\":31}]";
+    CHECK(accepted(coprime + "}"));
+    CHECK(accepted(coprime + ",\"horizon\":100000}"));
+    CHECK(not accepted(coprime + ",\"horizon\":1e15}"));
+    CHECK(not accepted("{\"algorithm\":\"RMS\",\"horizon\":1e15,\"processes\":[{\"burst\":1,\"period\":2}]}"));
+    
+    // a quantum, granularity or boost interval far below the bursts
+    CHECK(accepted("{\"algorithm\":\"RR\",\"quantum\":0.01,\"processes\":[{\"burst\":1000}]}"));
+    CHECK(not accepted("{\"algorithm\":\"RR\",\"quantum\":1e-6,\"processes\":[{\"burst\":1000}]}"));
+    CHECK(not accepted("{\"algorithm\":\"LOTTERY\",\"quantum\":1,\"processes\":[{\"burst\":1e9,\"priority\":1}]}"));
+    CHECK(not accepted("{\"algorithm\":\"CFS\",\"cfs\":{\"minGranularity\":1e-9},\"processes\":[{\"burst\":10,\"priority\":1}]}"));
+    CHECK(not accepted("{\"algorithm\":\"MLFQ\",\"mlfq\":{\"boostInterval\":1e-6},\"processes\":[{\"burst\":100}]}"));
+    CHECK(not accepted("{\"algorithm\":\"RR\",\"quantum\":1,\"processes\":[{\"arrival\":1e15,\"burst\":1}]}"));
+    CHECK(not accepted("{\"algorithm\":\"FCFS\",\"processes\":[{\"burst\":1e400}]}"));
+    
+    // too many i/o devices, refused without sizing them
+    CHECK(not accepted("{\"algorithm\":\"IO\",\"io\":{\"devices\":2000000000},\"processes\":[]}"));
+    CHECK(accepted("{\"algorithm\":\"IO\",\"io\":{\"devices\":4096},\"processes\":[]}"));
+    
+    // too many processes
+    std::string many = "{\"algorithm\":\"FCFS\",\"processes\":[";
+    for (int i = 0; i <= ScheduleRequest::maxProcesses; ++i){ many += (i) ? ",{\"burst\":1}" : "{\"burst\":1}"; }
+    CHECK(not accepted(many + "]}"));
+}
+
+
+TEST(ScheduleRequest, responseOfTheSchedule){
+    ScheduleRequest request;
+    std::vector<Process> processes;
+    CHECK(readRequest("{\"algorithm\":\"RR\",\"quantum\":2,\"processes\":[{\"arrival\":0,\"burst\":5},{\"arrival\":1,\"burst\":3}]}",
+                      request, processes) == nullptr);
+    SchedulingEngine engine;
+    request.configure(engine);
+    engine.simulate(processes, request.algorithm, request.quantum, request.cpuConfig);
+    
+    std::string out;
+    request.writeResponse(out, engine);
+    CHECK(out.find("\"algorithm\":\"RR\"") != std::string::npos);
+    CHECK(out.find("{\"processId\":1,\"start\":0,\"end\":2,\"cpu\":0,\"overhead\":false}") != std::string::npos);
+    CHECK(out.find("\"averageTurnaround\":7") != std::string::npos);   // completions 8 & 7
+    CHECK(out.find("\"makespan\":8") != std::string::npos);
+    CHECK(out.find("\"cpuUtilization\":1") != std::string::npos);
+    CHECK(out.find("\"window\"") == std::string::npos);
+    
+    // a window: only its segments (p2 2-4, p1 4-6 & p2 6-7), & its busy time
+    ScheduleRequest windowed;
+    CHECK(readRequest("{\"algorithm\":\"RR\",\"quantum\":2,\"window\":{\"from\":3,\"to\":6.5},"
+                      "\"processes\":[{\"arrival\":0,\"burst\":5},{\"arrival\":1,\"burst\":3}]}", windowed, processes) == nullptr);
+    windowed.writeResponse(out, engine);
+    CHECK(out.find("\"segments\":[\n{\"processId\":2,\"start\":2,\"end\":4,\"cpu\":0,\"overhead\":false},\n"
+                   "{\"processId\":1,\"start\":4,\"end\":6,\"cpu\":0,\"overhead\":false},\n"
+                   "{\"processId\":2,\"start\":6,\"end\":7,\"cpu\":0,\"overhead\":false}]") != std::string::npos);
+    CHECK(out.find("\"window\":{\"from\":3,\"to\":6.5,\"busyTime\":3.5,\"cpuUtilization\":1}") != std::string::npos);
+    windowed.windowTo = std::numeric_limits<double>::infinity(); // upto the end of the schedule
+    windowed.writeResponse(out, engine);
+    CHECK(out.find("\"window\":{\"from\":3,\"to\":8,\"busyTime\":5,") != std::string::npos);
+    CHECK(not accepted("{\"algorithm\":\"RR\",\"window\":{\"from\":5,\"to\":5},\"processes\":[]}"));
+    
+    // periodic tasks: the busy time of the jobs (4 x 1 + 2 x 2 in 16 units), the throughput in jobs
+    ScheduleRequest periodic;
+    CHECK(readRequest("{\"algorithm\":\"EDF\",\"horizon\":20,\"segments\":false,"
+                      "\"processes\":[{\"burst\":1,\"period\":5},{\"burst\":2,\"period\":10}]}", periodic, processes) == nullptr);
+    periodic.configure(engine);
+    engine.simulate(processes, periodic.algorithm, periodic.quantum, periodic.cpuConfig);
+    periodic.writeResponse(out, engine);
+    CHECK(out.find("\"segments\"") == std::string::npos);
+    CHECK(out.find("\"throughput\":0.375,\"cpuUtilization\":0.5,\"makespan\":16,\"jobs\":6,\"deadlineMisses\":0") != std::string::npos);
+}
@@ -0,0 +1,121 @@
+#include "Testing.hpp"
+#include "Results.hpp"
+#include <random>
+#include <map>
+
+
+static std::vector<Process> workload(const std::vector<std::vector<double>> &rows){ // arrival, burst
+    std::vector<Process> processes(rows.size());
+    for (std::size_t i = 0; i < rows.size(); ++i){
+        processes[i].id          = i + 1;
+        processes[i].priority    = 1;
+        processes[i].arrivalTime = rows[i][0];
+        processes[i].burstTime   = rows[i][1];
+    }
+    return processes;
+}
+
+// the segments of each cpu in time order
+static std::map<int, std::vector<GanttSegment>> lanes(const std::vector<GanttSegment> &segments){
+    std::map<int, std::vector<GanttSegment>> lanes;
+    for (const auto &segment : segments){ lanes[segment.core].push_back(segment); }
+    for (auto &lane : lanes){
+        std::sort(lane.second.begin(), lane.second.end(), [](const GanttSegment &s1, const GanttSegment &s2){
+            return  s1.startTime < s2.startTime;
+        });
+    }
+    return lanes;
+}
+
+// every overhead takes the whole switch cost, & every run of a process not warm on its cpu (another process ran
+// there since, or the process ran elsewhere since) comes right after its switch: the overhead is switches x cost
+static bool everySwitchCharged(const std::vector<GanttSegment> &segments, const double &cost){
+    std::vector<GanttSegment> byStart = segments;
+    std::stable_sort(byStart.begin(), byStart.end(), [](const GanttSegment &s1, const GanttSegment &s2){
+        return  s1.startTime < s2.startTime;
+    });
+    std::map<int, const GanttSegment *> lastOnCore;
+    std::map<int, int> lastCoreOfProcess;
+    for (const auto &segment : byStart){
+        if (segment.overhead  and  segment.endTime - segment.startTime != cost)  return false;
+        const GanttSegment *previous = lastOnCore[segment.core];
+        bool warm = previous  and  previous->processId == segment.processId  and
+                    lastCoreOfProcess.count(segment.processId)  and  lastCoreOfProcess[segment.processId] == segment.core;
+        bool switched = previous  and  previous->overhead  and  previous->processId == segment.processId  and
+                        previous->endTime == segment.startTime;
+        if (not segment.overhead  and  not warm  and  not switched)  return false;
+        lastOnCore[segment.core] = &segment;
+        if (not segment.overhead)  lastCoreOfProcess[segment.processId] = segment.core;
+    }
+    return true;
+}
+
+
+// a process that takes a cpu is never preempted during its switch, so it can't be warm on the cpu without paying
+// the switch, & the process it preempted can't take the cpu straight back for free
+TEST(SwitchCosts, multiCpuPreemptionPaysTheSwitch){
+    SwitchCostConfig switchCosts;
+    switchCosts.contextSwitch = 2;
+    CpuConfig cpuConfig;
+    cpuConfig.cores = 2;
+    
+    SchedulingEngine engine;
+    engine.setSwitchCostConfig(switchCosts);
+    engine.simulate(workload({ { 0, 6 }, { 0, 3 }, { 3, 4.5 } }), "SRTF", 2, cpuConfig);
+    auto cpu1 = lanes(engine.ganttSegments())[1];
+    CHECK(cpu1.size() == 4);
+    CHECK(cpu1.size() == 4  and  cpu1[2].processId == 3  and  cpu1[2].overhead  and  cpu1[2].startTime == 3  and  cpu1[2].endTime == 5);
+    CHECK(cpu1.size() == 4  and  cpu1[3].processId == 3  and  not cpu1[3].overhead  and  cpu1[3].endTime == 9.5);
+    CHECK(everySwitchCharged(engine.ganttSegments(), 2));
+    
+    // the switches of p1 & p2 end at 2, then p3 (arrived at 1) preempts p2, & p1 isn't split
+    engine.simulate(workload({ { 0, 10 }, { 0, 10 }, { 1, 8 } }), "SRTF", 2, cpuConfig);
+    int p1Segments = 0;
+    double overhead = 0;
+    for (const auto &segment : engine.ganttSegments()){
+        if (segment.processId == 1)  ++p1Segments;
+        if (segment.overhead)  overhead += segment.endTime - segment.startTime;
+    }
+    CHECK(p1Segments == 2  and  engine.processes()[0].completionTime == 12);
+    CHECK(overhead == 4 * 2);
+    CHECK(everySwitchCharged(engine.ganttSegments(), 2));
+}
+
+
+TEST(SwitchCosts, overheadIsSwitchesTimesCost){
+    std::mt19937 random(45);
+    SwitchCostConfig switchCosts;
+    switchCosts.contextSwitch = 0.75;
+    for (int round = 0; round < 300; ++round){
+        std::vector<Process> processes(1 + random() % 30);
+        for (std::size_t i = 0; i < processes.size(); ++i){
+            processes[i].id          = i + 1;
+            processes[i].priority    = 1 + random() % 5;
+            processes[i].arrivalTime = (random() % 40) * 0.5;
+            processes[i].burstTime   = 0.5 + (random() % 12) * 0.5;
+        }
+        // single cpu
+        for (const char *algorithm : { "FCFS", "SJF", "PR", "RR", "SRTF", "PRP", "MLFQ", "STRIDE" }){
+            SchedulingEngine engine;
+            engine.setSwitchCostConfig(switchCosts);
+            engine.simulate(processes, algorithm, 1.5);
+            CHECK(everySwitchCharged(engine.ganttSegments(), switchCosts.contextSwitch));
+        }
+        // multi cpu, shared & per-cpu queues
+        for (const char *algorithm : { "FCFS", "SJF", "PR", "RR", "SRTF", "PRP" }){
+            CpuConfig cpuConfig;
+            cpuConfig.cores         = 2 + round % 3;
+            cpuConfig.perCoreQueues = (round % 2 == 1);
+            cpuConfig.workStealing  = cpuConfig.loadBalancing = (round % 4 == 3);
+            SchedulingEngine engine;
+            engine.setSwitchCostConfig(switchCosts);
+            engine.simulate(processes, algorithm, 1.5, cpuConfig);
+            CHECK(everySwitchCharged(engine.ganttSegments(), switchCosts.contextSwitch));
+            
+            double ran = 0, burst = 0;
+            for (const auto &segment : engine.ganttSegments()){ if (not segment.overhead)  ran += segment.endTime - segment.startTime; }
+            for (const auto &process : processes){ burst += process.burstTime; }
+            CHECK(std::fabs(ran - burst) < 1e-9);
+        }
+    }
+}
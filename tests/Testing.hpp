@@ -0,0 +1,37 @@
+#ifndef __Testing__
+#define __Testing__
+
+
+#include <vector>
+#include <string>
+#include <cstdio>
+
+
+// the tests of scheduler_tests (see _tests.cc): TEST(suite, name){ ... } registers a test of a suite,
+// CHECK(condition) counts a failed condition & goes on, so one run reports every failure of a test
+struct TestCase {
+    const char  *suite;
+    const char  *name;
+    void       (*run)();
+};
+
+inline std::vector<TestCase> &testCases(){ static std::vector<TestCase> cases;  return cases; }
+inline int &testFailures(){ static int failures = 0;  return failures; }
+
+struct TestRegistration {
+    TestRegistration(const char *suite, const char *name, void (*run)()){ testCases().push_back({ suite, name, run }); }
+};
+
+inline void reportFailure(const char *file, const int line, const std::string &condition){
+    if (++testFailures() <= 50)  std::printf("  %s:%d: CHECK(%s) failed\n", file, line, condition.c_str());
+}
+
+#define TEST(suite, name) \
+    static void suite##_##name(); \
+    static TestRegistration suite##_##name##Registration(#suite, #name, suite##_##name); \
+    static void suite##_##name()
+
+#define CHECK(condition) do { if (not (condition))  reportFailure(__FILE__, __LINE__, #condition); } while (0)
+
+
+#endif // __Testing__
@@ -0,0 +1,93 @@
+#include "Testing.hpp"
+#include "Results.hpp"
+#include <random>
+
+
+// the tick engine gives the schedule of the double one, for times on the tick grid
+// (not cfs: its slices are weighted shares of the latency, off the grid, see tickCfsRunsEveryBurst)
+TEST(Ticks, parityWithUnits){
+    using Resolution = TickResolution<2>;
+    std::mt19937 random(34);
+    const char *algorithms[] = { "FCFS", "SJF", "PR", "RR", "SRTF", "PRP", "IO", "MLFQ", "STRIDE", "LOTTERY", "EDF", "RMS" };
+    
+    for (int round = 0; round < 150; ++round){
+        std::vector<Process> processes(1 + random() % 25);
+        for (std::size_t i = 0; i < processes.size(); ++i){
+            Process &process = processes[i];
+            process.id          = i + 1;
+            process.priority    = 1 + random() % 10;
+            process.arrivalTime = (random() % 40) * 0.5;
+            process.burstTime   = 0.5 + (random() % 12) * 0.5;
+            process.ioTime      = (random() % 6) * 0.5;
+            process.burstTime2  = (random() % 4) * 0.5;
+            process.period      = (random() % 3) ? 0 : 4 + (random() % 20) * 0.5;
+            process.deadline    = (process.period > 0  and  random() % 2) ? process.period - 0.5 : 0;
+        }
+        std::vector<BasicProcess<std::int64_t>> ticks = Resolution::toTicks(processes);
+        
+        for (const char *algorithm : algorithms){
+            for (int cores : { 1, 3 }){
+                CpuConfig cpuConfig;
+                cpuConfig.cores = cores;
+                SchedulingEngine units;
+                TickSchedulingEngine ticked;
+                units.simulate(processes, algorithm, 1.5, cpuConfig);
+                ticked.simulate(ticks, algorithm, Resolution::toTicks(1.5), cpuConfig);
+                
+                const auto &segments     = units.ganttSegments();
+                const auto &tickSegments = ticked.ganttSegments();
+                CHECK(segments.size() == tickSegments.size());
+                for (std::size_t i = 0; i < std::min(segments.size(), tickSegments.size()); ++i){
+                    CHECK(segments[i].processId == tickSegments[i].processId);
+                    CHECK(segments[i].startTime == Resolution::toUnits(tickSegments[i].startTime));
+                    CHECK(segments[i].endTime   == Resolution::toUnits(tickSegments[i].endTime));
+                    CHECK(segments[i].core      == tickSegments[i].core);
+                }
+                std::vector<Process> back = Resolution::toUnits(ticked.processes());
+                for (std::size_t i = 0; i < back.size(); ++i){
+                    const Process &process = units.processes()[i];
+                    CHECK(back[i].period         == process.period);
+                    CHECK(back[i].deadline       == process.deadline);
+                    CHECK(back[i].completionTime == process.completionTime);
+                    CHECK(back[i].waitingTime    == process.waitingTime);
+                    CHECK(back[i].responseTime   == process.responseTime);
+                }
+                CHECK(units.deadlineReport().jobs           == ticked.deadlineReport().jobs);
+                CHECK(units.deadlineReport().deadlineMisses == ticked.deadlineReport().deadlineMisses);
+            }
+        }
+    }
+}
+
+
+// cfs on ticks: the slices are rounded to whole ticks, every process still runs exactly its burst
+TEST(Ticks, tickCfsRunsEveryBurst){
+    using Resolution = TickResolution<4>;
+    std::mt19937 random(261);
+    CfsConfig cfs; // in ticks for the tick engine
+    cfs.targetLatency  = Resolution::toTicks(6.0);
+    cfs.minGranularity = Resolution::toTicks(0.75);
+    
+    for (int round = 0; round < 100; ++round){
+        std::vector<Process> processes(1 + random() % 25);
+        for (std::size_t i = 0; i < processes.size(); ++i){
+            processes[i].id          = i + 1;
+            processes[i].priority    = 1 + random() % 100;
+            processes[i].arrivalTime = (random() % 40) * 0.25;
+            processes[i].burstTime   = 0.25 + (random() % 40) * 0.25;
+        }
+        TickSchedulingEngine ticked;
+        ticked.setCfsConfig(cfs);
+        ticked.simulate(Resolution::toTicks(processes), "CFS", 1);
+        
+        std::vector<std::int64_t> ran(processes.size() + 1, 0);
+        for (const auto &segment : ticked.ganttSegments()){
+            CHECK(segment.endTime > segment.startTime);
+            if (not segment.overhead)  ran[segment.processId] += segment.endTime - segment.startTime;
+        }
+        for (const auto &process : ticked.processes()){
+            CHECK(ran[process.id] == process.burstTime);
+            CHECK(process.completionTime == process.arrivalTime + process.waitingTime + process.burstTime);
+        }
+    }
+}
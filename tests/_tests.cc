@@ -0,0 +1,22 @@
+#include "Testing.hpp"
+#include <cstring>
+
+
+// scheduler_tests [suite]: runs the tests of a suite (all without one), fails if a check failed
+// ctest runs every suite on its own (see CMakeLists.txt)
+int main(int argc, char *argv[]){
+    
+    const char *suite = (argc > 1) ? argv[1] : nullptr;
+    int ran = 0;
+    for (const auto &test : testCases()){
+        if (suite  and  std::strcmp(suite, test.suite) != 0)  continue;
+        
+        int failuresBefore = testFailures();
+        test.run();
+        std::printf("%s %s.%s\n", (testFailures() == failuresBefore) ? "ok  " : "FAIL", test.suite, test.name);
+        ++ran;
+    }
+    if (ran == 0){ std::printf("no tests in suite %s\n", (suite) ? suite : "(all)");  return 1; }
+    std::printf("%d tests, %d failed checks\n", ran, testFailures());
+    return  (testFailures() == 0) ? 0 : 1;
+}